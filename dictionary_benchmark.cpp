@@ -0,0 +1,74 @@
+#include <concurrent_dictionary.h++>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace PROJECT_NAME;
+
+static constexpr int KEY_COUNT = 4096, READS_PER_THREAD = 1 << 20;
+
+class LockedDictionary {
+    Dictionary<std::string, int> dictionary;
+    mutable std::mutex mutex;
+public:
+    void put(const std::string& key, int value) {
+        std::lock_guard lock { mutex };
+        dictionary.put(key, value);
+    }
+
+    [[nodiscard]]
+    std::optional<int> try_get(const std::string& key) const {
+        std::lock_guard lock { mutex };
+        return dictionary.try_get(key);
+    }
+};
+
+template<typename SharedDictionary>
+double measure_reads_per_second(const SharedDictionary& dictionary, const std::vector<std::string>& keys, int thread_count) {
+    std::vector<std::thread> threads;
+    std::vector<long long> sums(thread_count);
+    auto started_at = std::chrono::steady_clock::now();
+
+    for(int thread = 0; thread < thread_count; thread++) {
+        threads.emplace_back([&, thread] {
+            long long sum = 0;
+            for(int read = 0; read < READS_PER_THREAD; read++)
+                sum += *dictionary.try_get(keys[(static_cast<size_t>(read) * 7919 + thread) % KEY_COUNT]);
+
+            sums[thread] = sum;
+        });
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at).count();
+    return static_cast<double>(READS_PER_THREAD) * thread_count / seconds;
+}
+
+int main() {
+    std::vector<std::string> keys;
+    ConcurrentDictionary<std::string, int> concurrent_dictionary;
+    LockedDictionary locked_dictionary;
+
+    for(int key = 0; key < KEY_COUNT; key++) {
+        keys.push_back("key " + std::to_string(key));
+        concurrent_dictionary.put(keys.back(), key);
+        locked_dictionary.put(keys.back(), key);
+    }
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %24s %24s %8s\n", "threads", "concurrent reads/s", "mutex reads/s", "speedup");
+
+    for(int thread_count = 1; thread_count <= 64; thread_count *= 2) {
+        auto concurrent_reads = measure_reads_per_second(concurrent_dictionary, keys, thread_count);
+        auto locked_reads = measure_reads_per_second(locked_dictionary, keys, thread_count);
+        std::printf("%8d %24.0f %24.0f %7.2fx\n", thread_count, concurrent_reads, locked_reads, concurrent_reads / locked_reads);
+    }
+
+    return 0;
+}
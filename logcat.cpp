@@ -0,0 +1,26 @@
+#include <binary_logger.h++>
+#include <iostream>
+
+using namespace PROJECT_NAME;
+
+int main(int argc, char** argv) {
+    if(argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <binary log file> [message format]" << std::endl;
+        return 1;
+    }
+
+    try {
+        BinaryLogReader reader(argv[1]);
+        MessageFormatter formatter(argc == 3 ? argv[2] : DEFAULT_FORMATTER.get_message_format());
+        BinaryLogRecord record;
+
+        while(reader.next(record)) {
+            std::cout << BinaryLogReader::render(record, formatter);
+        }
+    } catch(const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
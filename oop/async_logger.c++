@@ -0,0 +1,170 @@
+#include <async_logger.h++>
+
+namespace PROJECT_NAME {
+    AsyncLogger::AsyncLogger(std::unique_ptr<AbstractLogger> sink, size_t capacity, OverflowPolicy overflow_policy, MessageFormatter formatter)
+        : AbstractLogger(std::move(formatter)), sink(std::move(sink)), records(capacity), overflow_policy(overflow_policy) {
+        if(!this->sink)
+            throw std::invalid_argument("Asynchronous logger cannot be created without a sink");
+
+        draining_thread = std::thread(&AsyncLogger::drain, this);
+    }
+
+    AsyncLogger::~AsyncLogger() {
+        stopping = true;
+        wake_draining_thread();
+        draining_thread.join();
+    }
+
+    void AsyncLogger::log(const std::string& message, LogLevel level) {
+        if(!is_enabled(level))
+            return;
+
+        auto metrics = get_active_metrics();
+        if(!metrics) {
+            Record record { level, message, std::chrono::system_clock::now(), false };
+            push(record);
+            return;
+        }
+
+        auto pushing_started_at = std::chrono::steady_clock::now();
+        Record record { level, message, std::chrono::system_clock::now(), false };
+        push(record);
+        auto pushing_finished_at = std::chrono::steady_clock::now();
+
+        metrics->record_caller(std::chrono::duration_cast<std::chrono::nanoseconds>(pushing_finished_at - pushing_started_at).count());
+    }
+
+    void AsyncLogger::write(const std::string& formatted_message) {
+        Record record { INFO, formatted_message, {}, true };
+        push(record);
+    }
+
+    void AsyncLogger::flush() {
+        auto flushing_target = accepted_count.load();
+        wake_draining_thread();
+
+        std::unique_lock lock { draining_mutex };
+        records_processed.wait(lock, [&] { return flushed_count >= flushing_target; });
+    }
+
+    unsigned long long AsyncLogger::get_dropped_count() const {
+        return dropped_count;
+    }
+
+    unsigned long long AsyncLogger::get_processed_count() const {
+        return processed_count;
+    }
+
+    size_t AsyncLogger::get_queue_size() const {
+        return records.size();
+    }
+
+    LoggerMetricsSnapshot AsyncLogger::snapshot() const {
+        auto snapshot = AbstractLogger::snapshot();
+        snapshot.queue_size = get_queue_size();
+        snapshot.dropped_count = get_dropped_count();
+        return snapshot;
+    }
+
+    LatencyHistogram AsyncLogger::get_write_latencies() const {
+        std::lock_guard lock { statistics_mutex };
+        return write_latencies;
+    }
+
+    void AsyncLogger::push(Record& record) {
+        switch(overflow_policy) {
+            case OverflowPolicy::BLOCK:
+                while(!records.try_push(record)) {
+                    wake_draining_thread();
+                    std::this_thread::yield();
+                }
+                break;
+            case OverflowPolicy::DROP:
+                if(!records.try_push(record)) {
+                    dropped_count++;
+                    return;
+                }
+                break;
+            case OverflowPolicy::DROP_OLDEST:
+                while(!records.try_push(record)) {
+                    Record oldest_record;
+                    if(records.try_pop(oldest_record)) {
+                        dropped_count++;
+                        processed_count++;
+                    }
+                }
+                break;
+        }
+
+        accepted_count++;
+
+        if(draining_thread_idle.load(std::memory_order_relaxed))
+            wake_draining_thread();
+    }
+
+    void AsyncLogger::wake_draining_thread() {
+        {
+            std::lock_guard lock { draining_mutex };
+        }
+
+        records_pushed.notify_one();
+    }
+
+    void AsyncLogger::drain() {
+        Record record;
+
+        while(true) {
+            size_t batch_size = 0;
+            while(batch_size < DRAINING_BATCH_SIZE && records.try_pop(record)) {
+                auto formatting_started_at = std::chrono::steady_clock::now();
+
+                const std::string* message = &record.message;
+                if(!record.formatted) {
+                    formatted_message.clear();
+                    formatter.format_to(formatted_message, record.message, record.level, record.timestamp);
+                    message = &formatted_message;
+                }
+
+                auto writing_started_at = std::chrono::steady_clock::now();
+                sink->write(*message);
+                auto writing_finished_at = std::chrono::steady_clock::now();
+
+                auto writing_time = std::chrono::duration_cast<std::chrono::nanoseconds>(writing_finished_at - writing_started_at).count();
+                batch_write_latencies[batch_size] = writing_time;
+                batch_size++;
+
+                if(auto metrics = get_active_metrics())
+                    metrics->record(message->size(), std::chrono::duration_cast<std::chrono::nanoseconds>(writing_started_at - formatting_started_at).count(), writing_time);
+            }
+
+            if(batch_size != 0) {
+                {
+                    std::lock_guard lock { statistics_mutex };
+                    for(size_t index = 0; index < batch_size; index++)
+                        write_latencies.record(batch_write_latencies[index]);
+                }
+
+                processed_count += batch_size;
+                continue;
+            }
+
+            std::unique_lock lock { draining_mutex };
+            if(flushed_count != processed_count) {
+                lock.unlock();
+                sink->flush();
+                lock.lock();
+
+                flushed_count = processed_count;
+                records_processed.notify_all();
+            }
+
+            if(stopping && records.size() == 0)
+                return;
+
+            draining_thread_idle = true;
+            if(records.size() == 0 && !stopping)
+                records_pushed.wait_for(lock, IDLE_WAITING_TIMEOUT);
+            draining_thread_idle = false;
+        }
+    }
+}
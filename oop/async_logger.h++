@@ -0,0 +1,149 @@
+/*
+ * -----------------------------------------------
+ * Asynchronous Logger
+ * -----------------------------------------------
+ * Moves formatting and writing off the caller's
+ * thread: records are pushed to a lock-free ring
+ * buffer, and a background thread drains it to
+ * the sink in batches.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "logger.h++"
+#include <utils/ring_buffer.h++>
+#include <utils/latency_histogram.h++>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace PROJECT_NAME {
+    /**
+     * Tells what an asynchronous logger does when its buffer is full:
+     * BLOCK waits for a free slot, DROP discards the new record,
+     * DROP_OLDEST discards the oldest buffered record to make room.
+     */
+    enum class OverflowPolicy {
+        BLOCK,
+        DROP,
+        DROP_OLDEST
+    };
+
+    class AsyncLogger : public AbstractLogger {
+        static constexpr size_t DRAINING_BATCH_SIZE = 256;
+        static constexpr std::chrono::milliseconds IDLE_WAITING_TIMEOUT { 10 };
+
+        struct Record {
+            LogLevel level = INFO;
+            std::string message;
+            std::chrono::system_clock::time_point timestamp;
+            bool formatted = false;
+        };
+
+        std::unique_ptr<AbstractLogger> sink;
+        RingBuffer<Record> records;
+        OverflowPolicy overflow_policy;
+        std::atomic<unsigned long long> accepted_count = 0, processed_count = 0, dropped_count = 0;
+        std::atomic<bool> draining_thread_idle = false, stopping = false;
+        unsigned long long flushed_count = 0;
+        std::mutex draining_mutex;
+        std::condition_variable records_pushed, records_processed;
+        std::thread draining_thread;
+        std::string formatted_message;
+        std::array<uint64_t, DRAINING_BATCH_SIZE> batch_write_latencies {};
+        LatencyHistogram write_latencies;
+        mutable std::mutex statistics_mutex;
+
+        void push(Record& record);
+
+        void drain();
+
+        void wake_draining_thread();
+    public:
+        /**
+         * Creates a new asynchronous logger and starts its background thread.
+         * Messages are formatted with this logger formatter, the sink only writes them.
+         *
+         * @throws std::invalid_argument When the sink is missing or the capacity is not a power of two
+         * @param sink The logger the records will be written to
+         * @param capacity A maximal count of buffered records, should be a power of two
+         * @param overflow_policy What to do when the buffer is full
+         * @param formatter The logger message formatter
+         */
+        explicit AsyncLogger(std::unique_ptr<AbstractLogger> sink, size_t capacity = 8192, OverflowPolicy overflow_policy = OverflowPolicy::BLOCK, MessageFormatter formatter = DEFAULT_FORMATTER);
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        /**
+         * Writes every buffered record to the sink and stops the background thread.
+         */
+        ~AsyncLogger() override;
+
+        /**
+         * Pushes the raw message to the buffer. It is formatted on the background thread.
+         *
+         * @param message The message
+         * @param level The log level
+         */
+        void log(const std::string& message, LogLevel level = INFO) override;
+
+        using AbstractLogger::log;
+
+        /**
+         * Pushes an already formatted message to the buffer.
+         *
+         * @param formatted_message The formatted message
+         */
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Waits until every record pushed so far is written, then flushes the sink.
+         */
+        void flush() override;
+
+        /**
+         * Takes a snapshot of the metrics, including the queue size and the count of dropped records.
+         * Records are counted and timed when the background thread formats and writes them.
+         *
+         * @return The metrics snapshot
+         */
+        [[nodiscard]]
+        LoggerMetricsSnapshot snapshot() const override;
+
+        /**
+         * Returns a count of records discarded because the buffer was full.
+         * @return The count of dropped records
+         */
+        [[nodiscard]]
+        unsigned long long get_dropped_count() const;
+
+        /**
+         * Returns a count of records written to the sink or dropped after they were buffered.
+         * @return The count of processed records
+         */
+        [[nodiscard]]
+        unsigned long long get_processed_count() const;
+
+        /**
+         * Returns an approximate count of records waiting in the buffer.
+         * @return The count of buffered records
+         */
+        [[nodiscard]]
+        size_t get_queue_size() const;
+
+        /**
+         * Returns the latencies of writing single records to the sink, in nanoseconds.
+         * @return A copy of the latency histogram
+         */
+        [[nodiscard]]
+        LatencyHistogram get_write_latencies() const;
+    };
+}
@@ -23,14 +23,36 @@ namespace PROJECT_NAME {
         int min_username_length = 4;
         int sign_in_password_enter_attempts = 3;
         std::vector<std::pair<std::string, std::string>> password_validation_rules;
+        Dictionary<std::string, bool> taken_user_names;
+        bool taken_user_names_loaded = false;
         ConsoleLogger logger;
     protected:
         auto load_existing_users() {
             return CSV().parse_file(user_database_filename, true);
         }
 
-        void save_users(const std::vector<std::vector<std::string>>& user_database) {
-            CSV().export_file(user_database_filename, user_database);
+        void load_taken_user_names() {
+            taken_user_names_loaded = true;
+
+            if(!std::filesystem::exists(user_database_filename))
+                return;
+
+            for(const auto& existing_user : CSV().stream(user_database_filename))
+                taken_user_names.put(existing_user[0], true);
+        }
+
+        bool is_user_name_taken(const std::string& user_name) {
+            if(!taken_user_names_loaded)
+                load_taken_user_names();
+
+            return taken_user_names.has(user_name);
+        }
+
+        void save_user(const std::vector<std::string>& user) {
+            CSV().append_row(user_database_filename, user);
+
+            if(taken_user_names_loaded)
+                taken_user_names.put(user[0], true);
         }
     public:
         auth() {
@@ -81,15 +103,13 @@ namespace PROJECT_NAME {
         }
 
         void sign_up() {
-            auto existing_users = load_existing_users();
-
             while(true) {
                 logger.log("Enter a name for your brand-new account: ");
 
                 std::string user_name;
                 std::getline(std::cin, user_name);
 
-                if(!existing_users.empty() && std::any_of(existing_users.begin(), existing_users.end(), [&](const auto& existing_user) { return existing_user[0] == user_name; })) {
+                if(is_user_name_taken(user_name)) {
                     logger.error("Unfortunately, somebody took this name. Please, choose something else");
                     continue;
                 } else if(user_name.length() < min_username_length) {
@@ -127,8 +147,7 @@ namespace PROJECT_NAME {
                     logger.log("Please, enter your passwords again. Ensure that they are following the rules and you will be able to remember it!");
                 }
                 logger.log("Successfully signed up!");
-                existing_users.push_back(std::vector<std::string> {user_name, bcrypt::generateHash(user_password) });
-                save_users(existing_users);
+                save_user(std::vector<std::string> {user_name, bcrypt::generateHash(user_password) });
                 break;
             }
         }
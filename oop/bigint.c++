@@ -1,4 +1,5 @@
 #include <bigint.h++>
+#include <utils/binary_io.h++>
 
 namespace PROJECT_NAME {
     bigint::bigint() : bigint("0") {
@@ -19,8 +20,17 @@ namespace PROJECT_NAME {
             }
         }
 
-        set_sign(numeric_string[0] != minus || numeric_string == "0");
-        this->numeric_string = is_unary_operator(numeric_string[0]) ? numeric_string.substr(1) : numeric_string;
+        size_t first_significant_digit = is_unary_operator(numeric_string[0]) ? 1 : 0;
+        if(first_significant_digit == numeric_string.length()) {
+            throw std::invalid_argument("String '"s + numeric_string + "' has no digits to be used as a value of big integer");
+        }
+
+        while(first_significant_digit + 1 < numeric_string.length() && numeric_string[first_significant_digit] == '0') {
+            first_significant_digit++;
+        }
+
+        this->numeric_string = numeric_string.substr(first_significant_digit);
+        set_sign(numeric_string[0] != minus || this->numeric_string == "0");
     }
 
     bigint::bigint(int integer) : bigint(std::to_string(integer)) {
@@ -195,8 +205,8 @@ namespace PROJECT_NAME {
 
                 int decimal_overflow = 0;
                 for(int i = count_digits() - 1; i >= 0; i--) {
-                    int sum = to_int(first[i]) + to_int(second[i]);
-                    result = std::to_string(sum % 10 + decimal_overflow) + result;
+                    int sum = to_int(first[i]) + to_int(second[i]) + decimal_overflow;
+                    result = std::to_string(sum % 10) + result;
                     decimal_overflow = sum / 10;
                 }
 
@@ -288,13 +298,15 @@ namespace PROJECT_NAME {
                 std::string single_multiplication_element;
 
                 for(int first_number_digit_index = first.length() - 1; first_number_digit_index >= 0; first_number_digit_index--) {
-                    int multiplication = to_int(first[first_number_digit_index]) * to_int(second[second_number_digit_index]) + decimal_overflow % 10;
+                    int multiplication = to_int(first[first_number_digit_index]) * to_int(second[second_number_digit_index]) + decimal_overflow;
                     single_multiplication_element = std::to_string(multiplication % 10) + single_multiplication_element;
                     decimal_overflow = multiplication / 10;
                 }
 
+                if(decimal_overflow != 0)
+                    single_multiplication_element = std::to_string(decimal_overflow) + single_multiplication_element;
+
                 single_multiplication_element += std::string(((int) second.length() - 1) - second_number_digit_index, '0');
-                std::cout << single_multiplication_element << '\n';
 
                 result += bigint(single_multiplication_element);
             }
@@ -330,6 +342,57 @@ namespace PROJECT_NAME {
         return *this;
     }
 
+    void bigint::write_binary(std::ostream& stream) const {
+        std::string buffer;
+        write_binary(buffer);
+        stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    void bigint::write_binary(std::string& buffer) const {
+        buffer.push_back(static_cast<char>(sign ? plus : minus));
+        append_binary_integer<uint32_t>(buffer, numeric_string.length());
+
+        for(size_t index = 0; index < numeric_string.length(); index += 2) {
+            int high = to_int(numeric_string[index]);
+            int low = index + 1 < numeric_string.length() ? to_int(numeric_string[index + 1]) : 0;
+            buffer.push_back(static_cast<char>((high << 4) | low));
+        }
+    }
+
+    bigint bigint::read_binary(std::istream& stream) {
+        char sign_character;
+        if(!stream.get(sign_character) || !is_unary_operator(sign_character)) {
+            throw std::runtime_error("Binary stream does not contain a big integer sign");
+        }
+
+        auto digit_count = read_binary_integer<uint32_t>(stream);
+        if(digit_count == 0) {
+            throw std::runtime_error("Binary stream contains a big integer without digits");
+        }
+
+        std::string numeric_string(digit_count, '0');
+
+        for(size_t index = 0; index < digit_count; index += 2) {
+            char packed_digits;
+            if(!stream.get(packed_digits)) {
+                throw std::runtime_error("Unexpected end of binary stream while reading big integer digits");
+            }
+
+            int high = (static_cast<unsigned char>(packed_digits) >> 4) & 0x0F;
+            int low = static_cast<unsigned char>(packed_digits) & 0x0F;
+
+            if(high > 9 || low > 9) {
+                throw std::runtime_error("Binary stream contains a malformed big integer digit");
+            }
+
+            numeric_string[index] = static_cast<char>('0' + high);
+            if(index + 1 < digit_count)
+                numeric_string[index + 1] = static_cast<char>('0' + low);
+        }
+
+        return sign_character + numeric_string;
+    }
+
     auto operator<<(std::ostream& stream, const bigint& integer) -> std::ostream& {
         return stream << integer.to_string();
     }
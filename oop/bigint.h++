@@ -352,6 +352,29 @@ namespace PROJECT_NAME {
         [[nodiscard]]
         bigint clone() const;
 
+        /**
+         * Writes this big integer to a binary stream in a compact form:
+         * a sign byte, a digit count and the digits packed two per byte.
+         *
+         * @param stream A binary output stream where this big integer will be written to
+         */
+        void write_binary(std::ostream& stream) const;
+
+        /**
+         * Appends this big integer to a buffer in the same form as write_binary(std::ostream&).
+         * @param buffer A buffer where this big integer will be appended to
+         */
+        void write_binary(std::string& buffer) const;
+
+        /**
+         * Reads a big integer, written with write_binary(), from a binary stream.
+         *
+         * @throws std::runtime_error When the stream ends or contains malformed digits
+         * @param stream A binary input stream where the big integer will be read from
+         * @return The big integer read
+         */
+        [[nodiscard]]
+        static bigint read_binary(std::istream& stream);
 
         /**
          * Makes big integers printable to output streams.
@@ -1,5 +1,412 @@
 #include "bigint_command_executor.h++"
+#include <utils/binary_io.h++>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace PROJECT_NAME {
-    // TODO: Implement the methods 
-}
\ No newline at end of file
+    static const std::string CHECKPOINT_SIGNATURE = "OOPCKPT";
+    static const char SINGLE_REGISTER_CHECKPOINT_VERSION = 1, CHECKPOINT_VERSION = 2;
+
+    bigint_command_executor::bigint_command_executor() {
+        register_command(ADD, +);
+        register_command(SUB, -);
+        register_command(MUL, *);
+
+        operations.set_inverse(operations.find("ADD"), operations.find("SUB"));
+    }
+
+    OperationRegistry::OperationId bigint_command_executor::register_operation(const std::string& name, OperationRegistry::Operation operation) {
+        return operations.register_operation(name, operation);
+    }
+
+    const OperationRegistry& bigint_command_executor::get_operations() const {
+        return operations;
+    }
+
+    void bigint_command_executor::push_command(const std::string& command) {
+        command_stack.push({ command, register_names });
+    }
+
+    void bigint_command_executor::push_random_command(unsigned int command_count) {
+        for(int i = 0; i < command_count; i++) {
+            int command_index = rand() % operations.size();
+            command_stack.push({ operations.get_name(command_index) + " " + bigint::random().to_string(), register_names });
+        }
+    }
+
+    const bigint& bigint_command_executor::run() {
+        bigint initial_value;
+        logger.info("Please, enter an initial value for the big integer command executor: ");
+        std::cin >> initial_value;
+
+        return run(initial_value);
+    }
+
+    const bigint& bigint_command_executor::run(const bigint& initial_value) {
+        registers.assign(register_names.size(), 0);
+        registers[ACCUMULATOR_REGISTER] = initial_value;
+        program_counter = commands_executed_count = commands_failed_count = 0;
+        history.clear();
+
+        return execute_pending_commands();
+    }
+
+    const bigint& bigint_command_executor::resume(const std::string& checkpoint_path) {
+        std::ifstream checkpoint_file { checkpoint_path, std::ios::binary };
+
+        if(!checkpoint_file.is_open())
+            throw std::runtime_error("Cannot open checkpoint file '"s + checkpoint_path + "' for resuming execution");
+
+        std::string signature(CHECKPOINT_SIGNATURE.length(), '\0');
+        char version;
+        if(!checkpoint_file.read(signature.data(), signature.length()) || signature != CHECKPOINT_SIGNATURE || !checkpoint_file.get(version) || (version != CHECKPOINT_VERSION && version != SINGLE_REGISTER_CHECKPOINT_VERSION)) {
+            throw std::runtime_error("File '"s + checkpoint_path + "' is not a big integer command executor checkpoint");
+        }
+
+        program_counter = read_binary_integer<uint64_t>(checkpoint_file);
+        commands_executed_count = read_binary_integer<uint64_t>(checkpoint_file);
+        commands_failed_count = read_binary_integer<uint64_t>(checkpoint_file);
+
+        registers.assign(register_names.size(), 0);
+        if(version == SINGLE_REGISTER_CHECKPOINT_VERSION) {
+            registers[ACCUMULATOR_REGISTER] = bigint::read_binary(checkpoint_file);
+        } else {
+            auto register_count = read_binary_integer<uint32_t>(checkpoint_file);
+
+            for(uint32_t saved_register = 0; saved_register < register_count; saved_register++) {
+                std::string register_name(read_binary_integer<uint32_t>(checkpoint_file), '\0');
+                checkpoint_file.read(register_name.data(), register_name.length());
+                bigint register_value = bigint::read_binary(checkpoint_file);
+
+                auto existing_register = std::find(register_names.begin(), register_names.end(), register_name);
+                if(existing_register == register_names.end()) {
+                    register_names.push_back(register_name);
+                    registers.push_back(register_value);
+                } else {
+                    registers[existing_register - register_names.begin()] = register_value;
+                }
+            }
+        }
+
+        history.clear();
+
+        for(unsigned long long skipped_command = 0; skipped_command < program_counter; skipped_command++) {
+            if(!command_stack.has_elements())
+                throw std::runtime_error("Checkpoint '"s + checkpoint_path + "' was made after " + std::to_string(program_counter) + " commands, but only " + std::to_string(skipped_command) + " are pushed. Please, push the same program before resuming");
+
+            command_stack.pop();
+        }
+
+        OOP_LOG_INFO(logger, "Resuming execution from checkpoint '"s + checkpoint_path + "' after " + std::to_string(program_counter) + " commands");
+        return execute_pending_commands();
+    }
+
+    void bigint_command_executor::set_log_level(LogLevel level) {
+        logger.set_level(level);
+    }
+
+    void bigint_command_executor::set_checkpointing(const std::string& checkpoint_path, unsigned int checkpoint_interval) {
+        this->checkpoint_path = checkpoint_path;
+        this->checkpoint_interval = checkpoint_interval;
+    }
+
+    void bigint_command_executor::set_thread_count(unsigned int thread_count) {
+        this->thread_count = std::max(1u, thread_count);
+        thread_pool.reset();
+    }
+
+    const bigint& bigint_command_executor::get_register(const std::string& name) const {
+        auto existing_register = std::find(register_names.begin(), register_names.end(), name);
+
+        if(existing_register == register_names.end())
+            throw std::invalid_argument("There is no register named '"s + name + "'");
+
+        static const bigint NOT_EXECUTED_REGISTER_VALUE = 0;
+        size_t register_index = existing_register - register_names.begin();
+        return register_index < registers.size() ? registers[register_index] : NOT_EXECUTED_REGISTER_VALUE;
+    }
+
+    void bigint_command_executor::enable_profiling(unsigned int result_sampling_interval) {
+        profiler = ExecutionProfiler(result_sampling_interval);
+        profiling_enabled = true;
+    }
+
+    void bigint_command_executor::disable_profiling() {
+        profiling_enabled = false;
+    }
+
+    const ExecutionProfiler& bigint_command_executor::get_profiler() const {
+        return profiler;
+    }
+
+    void bigint_command_executor::enable_history(size_t max_depth, size_t snapshot_interval) {
+        history = CommandHistory(max_depth, snapshot_interval);
+        history_enabled = true;
+    }
+
+    void bigint_command_executor::disable_history() {
+        history.clear();
+        history_enabled = false;
+    }
+
+    size_t bigint_command_executor::undo(size_t command_count) {
+        size_t undone_command_count = 0;
+        while(undone_command_count < command_count && history.undo(registers[ACCUMULATOR_REGISTER], operations)) {
+            undone_command_count++;
+        }
+
+        return undone_command_count;
+    }
+
+    size_t bigint_command_executor::redo(size_t command_count) {
+        size_t redone_command_count = 0;
+        while(redone_command_count < command_count && history.redo(registers[ACCUMULATOR_REGISTER], operations)) {
+            redone_command_count++;
+        }
+
+        return redone_command_count;
+    }
+
+    const CommandHistory& bigint_command_executor::get_history() const {
+        return history;
+    }
+
+    unsigned long long bigint_command_executor::get_program_counter() const {
+        return program_counter;
+    }
+
+    const bigint& bigint_command_executor::get_result() {
+        return registers[ACCUMULATOR_REGISTER];
+    }
+
+    const bigint& bigint_command_executor::load(const bigint_command_executor_command::operand& source) const {
+        return source.is_register() ? registers[source.register_index] : source.value;
+    }
+
+    void bigint_command_executor::execute_command(const bigint_command_executor_command& command, OperationRegistry::OperationId operation_id) {
+        if(command.is_in_place()) {
+            operations.invoke(operation_id, registers[command.get_destination()], load(command.get_second_source()));
+        } else {
+            bigint value = load(command.get_first_source());
+            operations.invoke(operation_id, value, load(command.get_second_source()));
+            registers[command.get_destination()] = std::move(value);
+        }
+    }
+
+    void bigint_command_executor::execute_window(const std::vector<bigint_command_executor_command>& window) {
+        std::vector<OperationRegistry::OperationId> operation_ids(window.size());
+        std::vector<size_t> last_writer_levels(registers.size(), 0), last_reader_levels(registers.size(), 0);
+        std::vector<std::vector<size_t>> levels(1);
+
+        for(size_t command_index = 0; command_index < window.size(); command_index++) {
+            const auto& command = window[command_index];
+            operation_ids[command_index] = operations.find(command.get_operation());
+
+            if(operation_ids[command_index] == OperationRegistry::UNKNOWN_OPERATION)
+                continue;
+
+            size_t destination = command.get_destination();
+            size_t level = std::max(last_writer_levels[destination], last_reader_levels[destination]);
+
+            for(const auto* source : { &command.get_first_source(), &command.get_second_source() }) {
+                if(source->is_register())
+                    level = std::max(level, last_writer_levels[source->register_index]);
+            }
+
+            level++;
+
+            for(const auto* source : { &command.get_first_source(), &command.get_second_source() }) {
+                if(source->is_register())
+                    last_reader_levels[source->register_index] = std::max(last_reader_levels[source->register_index], level);
+            }
+
+            last_writer_levels[destination] = level;
+
+            if(levels.size() <= level)
+                levels.resize(level + 1);
+            levels[level].push_back(command_index);
+        }
+
+        std::vector<uint64_t> operation_durations(profiling_enabled ? window.size() : 0);
+        std::vector<int> operand_digits(profiling_enabled ? window.size() : 0);
+
+        for(const auto& level : levels) {
+            std::optional<bigint> accumulator_before_assignment;
+
+            for(const auto& command_index : level) {
+                const auto& command = window[command_index];
+
+                if(profiling_enabled)
+                    operand_digits[command_index] = load(command.get_second_source()).count_digits();
+
+                if(history_enabled && command.get_destination() == ACCUMULATOR_REGISTER) {
+                    if(command.is_in_place()) {
+                        history.record(operation_ids[command_index], load(command.get_second_source()), registers[ACCUMULATOR_REGISTER], operations);
+                    } else {
+                        accumulator_before_assignment = registers[ACCUMULATOR_REGISTER];
+                    }
+                }
+            }
+
+            auto execute_level_command = [&](size_t level_command_index) {
+                size_t command_index = level[level_command_index];
+
+                if(profiling_enabled) {
+                    auto operation_start = std::chrono::steady_clock::now();
+                    execute_command(window[command_index], operation_ids[command_index]);
+                    auto operation_duration = std::chrono::steady_clock::now() - operation_start;
+
+                    operation_durations[command_index] = std::chrono::duration_cast<std::chrono::nanoseconds>(operation_duration).count();
+                } else {
+                    execute_command(window[command_index], operation_ids[command_index]);
+                }
+            };
+
+            if(level.size() > 1 && thread_count > 1) {
+                if(!thread_pool)
+                    thread_pool = std::make_unique<ThreadPool>(thread_count);
+
+                thread_pool->parallel_for(level.size(), execute_level_command);
+            } else {
+                for(size_t level_command_index = 0; level_command_index < level.size(); level_command_index++) {
+                    execute_level_command(level_command_index);
+                }
+            }
+
+            if(accumulator_before_assignment)
+                history.record(OperationRegistry::UNKNOWN_OPERATION, registers[ACCUMULATOR_REGISTER], *accumulator_before_assignment, operations);
+        }
+
+        for(size_t command_index = 0; command_index < window.size(); command_index++) {
+            if(operation_ids[command_index] == OperationRegistry::UNKNOWN_OPERATION) {
+                report_unknown_operation(window[command_index]);
+                commands_failed_count++;
+            } else {
+                if(profiling_enabled)
+                    profiler.record_command(window[command_index].get_operation(), operand_digits[command_index], operation_durations[command_index]);
+
+                commands_executed_count++;
+            }
+
+            program_counter++;
+
+            if(profiling_enabled)
+                profiler.record_result_size(program_counter, registers[ACCUMULATOR_REGISTER].count_digits());
+        }
+    }
+
+    std::string bigint_command_executor::suggest_operation(const std::string& unknown_operation) const {
+        std::string suggested_operation = operations.get_name(0);
+
+        double maximal_similarity = 0;
+        for(const auto& existing_command_operation : operations.get_names())  {
+            if(similarity(unknown_operation, existing_command_operation) > maximal_similarity) {
+                suggested_operation = existing_command_operation;
+                maximal_similarity = similarity(unknown_operation, existing_command_operation);
+            }
+        }
+
+        return suggested_operation;
+    }
+
+    void bigint_command_executor::report_unknown_operation(const bigint_command_executor_command& command) {
+        OOP_LOG_SAMPLED(logger, ERROR, UNKNOWN_OPERATION_REPORTS_LOGGED, UNKNOWN_OPERATION_REPORTS_SAMPLING, "Operation "s + command.get_operation() + " is not provided. Did you mean " + suggest_operation(command.get_operation()) + "?");
+    }
+
+    const bigint& bigint_command_executor::execute_pending_commands() {
+        if(!operations.is_finalized())
+            operations.finalize();
+
+        registers.resize(register_names.size(), 0);
+
+        bool checkpointing_enabled = checkpoint_interval != 0 && !checkpoint_path.empty();
+        std::vector<bigint_command_executor_command> window;
+
+        while(command_stack.has_elements()) {
+            size_t window_size = checkpointing_enabled ? std::min<size_t>(SCHEDULING_WINDOW, checkpoint_interval - program_counter % checkpoint_interval) : SCHEDULING_WINDOW;
+
+            window.clear();
+            while(window.size() < window_size && command_stack.has_elements()) {
+                window.push_back(command_stack.pop());
+            }
+
+            execute_window(window);
+
+            if(checkpointing_enabled && program_counter % checkpoint_interval == 0) {
+                save_checkpoint();
+            }
+        }
+
+        if(profiling_enabled)
+            profiler.record_result_size(program_counter, registers[ACCUMULATOR_REGISTER].count_digits(), true);
+
+        OOP_LOG_INFO(logger, "Execution is completed ("s + std::to_string(commands_executed_count) + " commands executed successfully" + (commands_failed_count == 0 ? ""s : ", but "s + std::to_string(commands_failed_count) + " failed") + ")");
+        OOP_LOG_INFO(logger, "The result of execution: "s + registers[ACCUMULATOR_REGISTER].to_string());
+        return registers[ACCUMULATOR_REGISTER];
+    }
+
+    void bigint_command_executor::save_checkpoint() const {
+        std::string temporary_checkpoint_path = checkpoint_path + ".tmp";
+        std::string checkpoint;
+
+        checkpoint.append(CHECKPOINT_SIGNATURE);
+        checkpoint.push_back(CHECKPOINT_VERSION);
+        append_binary_integer<uint64_t>(checkpoint, program_counter);
+        append_binary_integer<uint64_t>(checkpoint, commands_executed_count);
+        append_binary_integer<uint64_t>(checkpoint, commands_failed_count);
+        append_binary_integer<uint32_t>(checkpoint, registers.size());
+        for(size_t register_index = 0; register_index < registers.size(); register_index++) {
+            append_binary_integer<uint32_t>(checkpoint, register_names[register_index].length());
+            checkpoint.append(register_names[register_index]);
+            registers[register_index].write_binary(checkpoint);
+        }
+
+        int checkpoint_descriptor = ::open(temporary_checkpoint_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if(checkpoint_descriptor == -1)
+            throw std::runtime_error("Cannot open file '"s + temporary_checkpoint_path + "' for writing a checkpoint: " + std::strerror(errno));
+
+        size_t written = 0;
+        while(written < checkpoint.size()) {
+            auto result = ::write(checkpoint_descriptor, checkpoint.data() + written, checkpoint.size() - written);
+            if(result == -1 && errno == EINTR)
+                continue;
+
+            if(result == -1) {
+                auto error = errno;
+                ::close(checkpoint_descriptor);
+                ::unlink(temporary_checkpoint_path.c_str());
+                throw std::runtime_error("Cannot write a checkpoint to file '"s + temporary_checkpoint_path + "': " + std::strerror(error));
+            }
+
+            written += result;
+        }
+
+        if(::fsync(checkpoint_descriptor) == -1) {
+            auto error = errno;
+            ::close(checkpoint_descriptor);
+            ::unlink(temporary_checkpoint_path.c_str());
+            throw std::runtime_error("Checkpoint file '"s + temporary_checkpoint_path + "' cannot be synchronized: " + std::strerror(error));
+        }
+
+        ::close(checkpoint_descriptor);
+
+        if(::rename(temporary_checkpoint_path.c_str(), checkpoint_path.c_str()) == -1) {
+            auto error = errno;
+            ::unlink(temporary_checkpoint_path.c_str());
+            throw std::runtime_error("Checkpoint file '"s + temporary_checkpoint_path + "' cannot be renamed to '" + checkpoint_path + "': " + std::strerror(error));
+        }
+
+        auto directory = std::filesystem::path(checkpoint_path).parent_path();
+        int directory_descriptor = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if(directory_descriptor != -1) {
+            ::fsync(directory_descriptor);
+            ::close(directory_descriptor);
+        }
+    }
+}
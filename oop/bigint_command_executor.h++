@@ -14,29 +14,108 @@
 #include "bigint.h++"
 #include "stack.h++"
 #include "logger.h++"
-#include "dictionary.h++"
-#include <functional>
+#include "log_limiter.h++"
+#include "execution_profiler.h++"
+#include "operation_registry.h++"
+#include "command_history.h++"
 #include <utils/strings.h++>
+#include <utils/thread_pool.h++>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
-#define register_command(NAME, OPERATOR) registered_commands.put(#NAME, [](auto& destination, const auto& operand) { \
+#define register_command(NAME, OPERATOR) operations.register_operation(#NAME, [](bigint& destination, const bigint& operand) { \
 destination OPERATOR ## = operand;\
 })
 
 namespace PROJECT_NAME {
     class bigint_command_executor {
+        static constexpr size_t ACCUMULATOR_REGISTER = 0;
+        static constexpr size_t SCHEDULING_WINDOW = 4096;
+        static constexpr uint64_t UNKNOWN_OPERATION_REPORTS_LOGGED = 10;
+        static constexpr uint64_t UNKNOWN_OPERATION_REPORTS_SAMPLING = 1000;
+
         class bigint_command_executor_command {
+        public:
+            static constexpr size_t LITERAL_OPERAND = std::numeric_limits<size_t>::max();
+
+            struct operand {
+                size_t register_index = LITERAL_OPERAND;
+                bigint value;
+
+                [[nodiscard]]
+                bool is_register() const {
+                    return register_index != LITERAL_OPERAND;
+                }
+            };
+        private:
             std::string operation;
-            bigint value;
+            size_t destination = ACCUMULATOR_REGISTER;
+            operand first_source, second_source;
+            bool in_place = true;
+
+            static bool is_register_name(const std::string& token) {
+                return !token.empty() && (isalpha(token[0]) || token[0] == '_') && std::all_of(token.begin(), token.end(), [](char character) {
+                    return isalnum(character) || character == '_';
+                });
+            }
+
+            static size_t resolve_register(const std::string& raw_command, const std::string& name, std::vector<std::string>& register_names) {
+                if(!is_register_name(name))
+                    throw std::invalid_argument("String '" + name + "' in command '" + raw_command + "' cannot be used as a register name.");
+
+                auto existing_register = std::find(register_names.begin(), register_names.end(), name);
+                if(existing_register != register_names.end())
+                    return existing_register - register_names.begin();
+
+                register_names.push_back(name);
+                return register_names.size() - 1;
+            }
+
+            static operand parse_operand(const std::string& raw_command, const std::string& token, std::vector<std::string>& register_names) {
+                if(is_register_name(token))
+                    return { resolve_register(raw_command, token, register_names), 0 };
+
+                return { LITERAL_OPERAND, token };
+            }
         public:
-            bigint_command_executor_command(const std::string& raw_command) {
+            /**
+             * Parses a command of one of the forms:
+             * 'OP value' applies the value to the accumulator,
+             * 'OP destination value' applies the value to the destination register,
+             * 'OP destination first second' stores 'first OP second' to the destination register.
+             * Values are either big integer literals or register names.
+             *
+             * @throws std::invalid_argument When the string is not a command
+             * @param raw_command The command string, e.g. 'MUL r1 r2 r3'
+             * @param register_names The register names known so far, new ones are appended to it
+             */
+            bigint_command_executor_command(const std::string& raw_command, std::vector<std::string>& register_names) {
                 auto entries = split_string(raw_command, " ");
 
-                if(entries.size() != 2)
+                if(entries.size() < 2 || entries.size() > 4)
                     throw std::invalid_argument("String '" + raw_command + "' cannot be used as a big integer command executor command.");
 
                 operation = entries[0];
-                value = entries[1];
+
+                if(entries.size() == 2) {
+                    second_source = parse_operand(raw_command, entries[1], register_names);
+                } else {
+                    destination = resolve_register(raw_command, entries[1], register_names);
+                    in_place = entries.size() == 3;
+
+                    if(!in_place)
+                        first_source = parse_operand(raw_command, entries[2], register_names);
+
+                    second_source = parse_operand(raw_command, entries.back(), register_names);
+                }
+
+                if(in_place)
+                    first_source = { destination, 0 };
             }
 
             [[nodiscard]]
@@ -46,67 +125,244 @@ namespace PROJECT_NAME {
 
             [[nodiscard]]
             const bigint& get_value() const {
-                return value;
+                return second_source.value;
+            }
+
+            [[nodiscard]]
+            size_t get_destination() const {
+                return destination;
+            }
+
+            [[nodiscard]]
+            const operand& get_first_source() const {
+                return first_source;
+            }
+
+            [[nodiscard]]
+            const operand& get_second_source() const {
+                return second_source;
+            }
+
+            [[nodiscard]]
+            bool is_in_place() const {
+                return in_place;
             }
         };
 
-        bigint command_execution_result;
+        std::vector<std::string> register_names = { "acc" };
+        std::vector<bigint> registers = { 0 };
         ConsoleLogger logger;
-        Dictionary<std::string, std::function<void(bigint&, const bigint&)>> registered_commands;
+        OperationRegistry operations;
         Stack<bigint_command_executor_command> command_stack;
+        std::string checkpoint_path;
+        unsigned int checkpoint_interval = 0;
+        unsigned long long program_counter = 0, commands_executed_count = 0, commands_failed_count = 0;
+        ExecutionProfiler profiler;
+        bool profiling_enabled = false;
+        CommandHistory history;
+        bool history_enabled = false;
+        unsigned int thread_count = std::max(1u, std::thread::hardware_concurrency());
+        std::unique_ptr<ThreadPool> thread_pool;
+
+        /**
+         * Returns the value of an operand, reading the register if the operand is a register.
+         * @param source The operand
+         * @return The operand value
+         */
+        [[nodiscard]]
+        const bigint& load(const bigint_command_executor_command::operand& source) const;
+
+        /**
+         * Executes a single known command. Commands writing different registers
+         * and not reading the registers written by each other can be executed concurrently.
+         *
+         * @param command The command
+         * @param operation_id The command operation id
+         */
+        void execute_command(const bigint_command_executor_command& command, OperationRegistry::OperationId operation_id);
+
+        /**
+         * Executes a window of consecutive commands. The window is split into levels
+         * of the dataflow graph: a command gets a level greater than the levels of
+         * the commands writing registers it reads or writes, and of the commands
+         * reading the register it writes. Commands of the same level are independent,
+         * so they are run concurrently, and the result is the same as if the commands
+         * were executed one by one.
+         *
+         * @param window The commands in the program order
+         */
+        void execute_window(const std::vector<bigint_command_executor_command>& window);
+
+        /**
+         * Returns the known operation most similar to the unknown one.
+         *
+         * @param unknown_operation The unknown operation name
+         * @return The suggested operation name
+         */
+        [[nodiscard]]
+        std::string suggest_operation(const std::string& unknown_operation) const;
+
+        /**
+         * Logs an error about an unknown operation suggesting the most similar known one.
+         * Only the first reports and then every UNKNOWN_OPERATION_REPORTS_SAMPLING-th one
+         * are logged, so a bad program does not flood the log.
+         *
+         * @param command The command with an unknown operation
+         */
+        void report_unknown_operation(const bigint_command_executor_command& command);
+
+        /**
+         * Executes all the pending commands over the current registers,
+         * writing checkpoints on the way if they are enabled.
+         *
+         * @return The result of execution
+         */
+        const bigint& execute_pending_commands();
+
+        /**
+         * Writes the registers, the program counter and the execution counters
+         * to the checkpoint file. The file is replaced atomically, so a crash
+         * while writing keeps the previous checkpoint intact.
+         */
+        void save_checkpoint() const;
     public:
-        bigint_command_executor() {
-            register_command(ADD, +);
-            register_command(SUB, -);
-            register_command(MUL, *);
-        }
-
-        void push_command(const std::string& command) {
-            command_stack.push({ command });
-        }
-
-        void push_random_command(unsigned int command_count = 1) {
-            for(int i = 0; i < command_count; i++) {
-                int command_index = rand() % registered_commands.size();
-                command_stack.push({ registered_commands.get_keys()[command_index] + " " + bigint::random().to_string() });
-            }
-        }
+        bigint_command_executor();
 
-        const bigint& run() {
-            std::string initial_command_executor_value;
-            logger.info("Please, enter an initial value for the big integer command executor: ");
-            std::cin >> command_execution_result;
+        /**
+         * Registers a custom operation, e.g. POW or SHL, or replaces a built-in one.
+         * The operation should be a plain function or a lambda without captures.
+         *
+         * @param name The operation name used in commands
+         * @param operation The operation, which applies an operand to the result
+         * @return The operation id
+         */
+        OperationRegistry::OperationId register_operation(const std::string& name, OperationRegistry::Operation operation);
 
-            int commands_executed_count = 0, commands_failed_count = 0;
+        [[nodiscard]]
+        const OperationRegistry& get_operations() const;
 
-            while(command_stack.has_elements()) {
-                auto executing_command = command_stack.pop();
-                if(registered_commands.has(executing_command.get_operation())) {
-                    registered_commands[executing_command.get_operation()](command_execution_result, executing_command.get_value());
-                    commands_executed_count++;
-                } else {
-                    std::string suggested_operation = registered_commands.get_keys()[0];
-
-                    double maximal_similarity = 0;
-                    for(const auto& existing_command_operation : registered_commands.get_keys())  {
-                        if(similarity(executing_command.get_operation(), existing_command_operation) > maximal_similarity) {
-                            suggested_operation = existing_command_operation;
-                            maximal_similarity = similarity(executing_command.get_operation(), existing_command_operation);
-                        }
-                    }
-
-                    logger.error("Operation "s + executing_command.get_operation() + " is not provided. Did you mean " + suggested_operation + "?");
-                    commands_failed_count++;
-                }
-            }
+        void push_command(const std::string& command);
+
+        void push_random_command(unsigned int command_count = 1);
+
+        /**
+         * Asks the user for an initial value and executes all the pending commands.
+         *
+         * @return The result of execution
+         */
+        const bigint& run();
+
+        /**
+         * Executes all the pending commands starting from the passed initial value
+         * of the accumulator. Other registers start from 0.
+         *
+         * @param initial_value An initial value for the big integer command executor
+         * @return The result of execution
+         */
+        const bigint& run(const bigint& initial_value);
+
+        /**
+         * Restores the registers and the program counter from a checkpoint
+         * and executes the rest of the pending commands. The same program
+         * should be pushed before resuming, since the commands executed before
+         * the checkpoint are skipped rather than stored in it.
+         *
+         * @throws std::runtime_error When the checkpoint cannot be read or does not match the pushed program
+         * @param checkpoint_path The checkpoint file written by a previous run
+         * @return The result of execution
+         */
+        const bigint& resume(const std::string& checkpoint_path);
+
+        /**
+         * Sets a count of threads independent commands are executed on.
+         * Pass 1 to execute all the commands on the calling thread.
+         *
+         * @param thread_count A count of threads
+         */
+        void set_thread_count(unsigned int thread_count);
+
+        /**
+         * Returns the value of a register.
+         *
+         * @throws std::invalid_argument When there is no register with the passed name
+         * @param name The register name, 'acc' is the accumulator
+         * @return The register value
+         */
+        [[nodiscard]]
+        const bigint& get_register(const std::string& name) const;
+
+        /**
+         * Sets the minimal level of the messages the executor logs.
+         * @param level The minimal log level
+         */
+        void set_log_level(LogLevel level);
+
+        /**
+         * Enables periodic checkpoints. Every 'checkpoint_interval' executed commands,
+         * the registers are written to the 'checkpoint_path' file in a compact binary form.
+         * Pass 0 as an interval to disable checkpoints.
+         *
+         * @param checkpoint_path The file where checkpoints will be written to
+         * @param checkpoint_interval A count of commands between checkpoints
+         */
+        void set_checkpointing(const std::string& checkpoint_path, unsigned int checkpoint_interval);
+
+        /**
+         * Enables the execution profiler. While it is enabled, every executed command
+         * is timed and the size of the result is sampled.
+         *
+         * @param result_sampling_interval A count of commands between result size samples
+         */
+        void enable_profiling(unsigned int result_sampling_interval = 1024);
+
+        /**
+         * Disables the execution profiler, keeping everything it has recorded.
+         */
+        void disable_profiling();
+
+        /**
+         * Returns the execution profiler. Its report can be exported with ExecutionProfiler::export_json().
+         * @return The execution profiler
+         */
+        [[nodiscard]]
+        const ExecutionProfiler& get_profiler() const;
+
+        /**
+         * Enables the undo/redo history of the result. Executed commands are kept
+         * as steps, and the result is copied only once per 'snapshot_interval' steps.
+         *
+         * @param max_depth A maximal count of commands that can be undone
+         * @param snapshot_interval A count of commands between snapshots of the result
+         */
+        void enable_history(size_t max_depth = 1024, size_t snapshot_interval = 64);
+
+        /**
+         * Disables the undo/redo history and forgets it.
+         */
+        void disable_history();
+
+        /**
+         * Reverts the last executed commands.
+         *
+         * @param command_count A count of commands to revert
+         * @return A count of commands actually reverted
+         */
+        size_t undo(size_t command_count = 1);
+
+        /**
+         * Executes the last reverted commands again.
+         *
+         * @param command_count A count of commands to execute again
+         * @return A count of commands actually executed again
+         */
+        size_t redo(size_t command_count = 1);
+
+        [[nodiscard]]
+        const CommandHistory& get_history() const;
 
-            logger.info("Execution is completed ("s + std::to_string(commands_executed_count) + " commands executed successfully" + (commands_failed_count == 0 ? ""s : ", but "s + std::to_string(commands_failed_count) + " failed") + ")");
-            logger.info("The result of execution: "s + command_execution_result.to_string());
-            return command_execution_result;
-        }
+        [[nodiscard]]
+        unsigned long long get_program_counter() const;
 
-        const bigint& get_result() {
-            return command_execution_result;
-        }
+        const bigint& get_result();
     };
 }
@@ -0,0 +1,248 @@
+#include <binary_logger.h++>
+#include <array>
+#include <charconv>
+#include <iterator>
+
+namespace PROJECT_NAME {
+    std::vector<BinaryLogFormat>& BinaryLogger::get_formats() {
+        static std::vector<BinaryLogFormat> formats;
+        return formats;
+    }
+
+    std::mutex& BinaryLogger::get_formats_mutex() {
+        static std::mutex formats_mutex;
+        return formats_mutex;
+    }
+
+    BinaryLogger::FormatId BinaryLogger::register_format(std::string_view format, LogLevel level) {
+        return register_format(format, level, false);
+    }
+
+    BinaryLogger::FormatId BinaryLogger::register_format(std::string_view format, LogLevel level, bool preformatted) {
+        std::lock_guard lock { get_formats_mutex() };
+        auto& formats = get_formats();
+
+        for(FormatId format_id = 0; format_id < formats.size(); format_id++) {
+            const auto& existing_format = formats[format_id];
+            if(existing_format.severity == level.get_severity() && existing_format.level_tag == level.get_tag() && existing_format.format == format && existing_format.preformatted == preformatted)
+                return format_id;
+        }
+
+        formats.push_back({ level.get_severity(), std::string(level.get_tag()), std::string(format), preformatted });
+        return formats.size() - 1;
+    }
+
+    BinaryLogger::BinaryLogger(const std::string& logger_filename, size_t buffer_size)
+        : file_output_stream(logger_filename, std::ios::binary | std::ios::trunc), buffer_size(buffer_size) {
+        if(!file_output_stream)
+            throw std::runtime_error("Binary log file '"s + logger_filename + "' cannot be opened");
+
+        buffer.reserve(buffer_size);
+        buffer.append(FILE_SIGNATURE);
+        buffer.push_back(static_cast<char>(FILE_VERSION));
+    }
+
+    BinaryLogger::~BinaryLogger() {
+        std::lock_guard lock { buffer_mutex };
+        write_buffer();
+    }
+
+    void BinaryLogger::begin_record(FormatId format_id, uint8_t argument_count) {
+        if(format_id >= defined_formats.size())
+            defined_formats.resize(format_id + 1, false);
+
+        if(!defined_formats[format_id]) {
+            BinaryLogFormat format;
+            {
+                std::lock_guard lock { get_formats_mutex() };
+                if(format_id >= get_formats().size())
+                    throw std::invalid_argument("Binary log format #"s + std::to_string(format_id) + " is not registered");
+
+                format = get_formats()[format_id];
+            }
+
+            buffer.push_back(FORMAT_DEFINITION_TAG);
+            append_binary_integer<uint32_t>(buffer, format_id);
+            append_binary_integer<uint32_t>(buffer, format.severity);
+            buffer.push_back(static_cast<char>(format.preformatted));
+            append_binary_integer<uint32_t>(buffer, format.level_tag.size());
+            buffer.append(format.level_tag);
+            append_binary_integer<uint32_t>(buffer, format.format.size());
+            buffer.append(format.format);
+            defined_formats[format_id] = true;
+        }
+
+        auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+        buffer.push_back(RECORD_TAG);
+        append_binary_integer<uint32_t>(buffer, format_id);
+        append_binary_integer<uint64_t>(buffer, static_cast<uint64_t>(timestamp));
+        buffer.push_back(static_cast<char>(argument_count));
+    }
+
+    void BinaryLogger::end_record() {
+        if(buffer.size() >= buffer_size)
+            write_buffer();
+    }
+
+    void BinaryLogger::write_buffer() {
+        if(buffer.empty())
+            return;
+
+        file_output_stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+        if(auto metrics = get_active_metrics())
+            metrics->record_output(buffer.size());
+
+        buffer.clear();
+    }
+
+    void BinaryLogger::log(const std::string& message, LogLevel level) {
+        if(!is_enabled(level))
+            return;
+
+        static const LogLevel builtin_levels[] = { TRACE, DEBUG, INFO, WARNING, ERROR };
+        static const auto builtin_level_format_ids = [] {
+            std::array<FormatId, std::size(builtin_levels)> format_ids {};
+            for(size_t severity = 0; severity < format_ids.size(); severity++)
+                format_ids[severity] = register_format(ARGUMENT_PLACEHOLDER, builtin_levels[severity], false);
+
+            return format_ids;
+        }();
+
+        auto severity = level.get_severity();
+        if(severity < builtin_level_format_ids.size() && builtin_levels[severity].get_tag() == level.get_tag()) {
+            log_binary(builtin_level_format_ids[severity], message);
+            return;
+        }
+
+        log_binary(register_format(ARGUMENT_PLACEHOLDER, level, false), message);
+    }
+
+    void BinaryLogger::write(const std::string& formatted_message) {
+        static const auto preformatted_format_id = register_format(ARGUMENT_PLACEHOLDER, INFO, true);
+        log_binary(preformatted_format_id, formatted_message);
+    }
+
+    void BinaryLogger::flush() {
+        std::lock_guard lock { buffer_mutex };
+        write_buffer();
+        file_output_stream.flush();
+    }
+
+    BinaryLogReader::BinaryLogReader(const std::string& log_filename) : file_input_stream(log_filename, std::ios::binary) {
+        if(!file_input_stream)
+            throw std::runtime_error("Binary log file '"s + log_filename + "' cannot be opened");
+
+        std::string signature(BinaryLogger::FILE_SIGNATURE.size(), '\0');
+        char version;
+        if(!file_input_stream.read(signature.data(), static_cast<std::streamsize>(signature.size())) || signature != BinaryLogger::FILE_SIGNATURE || !file_input_stream.get(version))
+            throw std::runtime_error("File '"s + log_filename + "' is not a binary log");
+
+        if(static_cast<uint8_t>(version) != BinaryLogger::FILE_VERSION)
+            throw std::runtime_error("Binary log '"s + log_filename + "' has unsupported version " + std::to_string(static_cast<uint8_t>(version)));
+    }
+
+    std::string BinaryLogReader::read_string() {
+        std::string string(read_binary_integer<uint32_t>(file_input_stream), '\0');
+
+        if(!file_input_stream.read(string.data(), static_cast<std::streamsize>(string.size())))
+            throw std::runtime_error("Unexpected end of binary log while reading a string");
+
+        return string;
+    }
+
+    void BinaryLogReader::read_format_definition() {
+        auto format_id = read_binary_integer<uint32_t>(file_input_stream);
+
+        BinaryLogFormat format;
+        format.severity = read_binary_integer<uint32_t>(file_input_stream);
+        format.preformatted = read_binary_integer<uint8_t>(file_input_stream) != 0;
+        format.level_tag = read_string();
+        format.format = read_string();
+        formats[format_id] = std::move(format);
+    }
+
+    void BinaryLogReader::read_argument(std::string& message) {
+        auto type = static_cast<BinaryLogArgumentType>(read_binary_integer<uint8_t>(file_input_stream));
+
+        switch(type) {
+            case BinaryLogArgumentType::SIGNED_INTEGER:
+                message += std::to_string(static_cast<int64_t>(read_binary_integer<uint64_t>(file_input_stream)));
+                break;
+            case BinaryLogArgumentType::UNSIGNED_INTEGER:
+                message += std::to_string(read_binary_integer<uint64_t>(file_input_stream));
+                break;
+            case BinaryLogArgumentType::FLOATING_POINT: {
+                char digits[32];
+                auto value = std::bit_cast<double>(read_binary_integer<uint64_t>(file_input_stream));
+                auto result = std::to_chars(digits, digits + sizeof(digits), value);
+                message.append(digits, result.ptr);
+                break;
+            }
+            case BinaryLogArgumentType::STRING:
+                message += read_string();
+                break;
+            case BinaryLogArgumentType::BIG_INTEGER:
+                message += bigint::read_binary(file_input_stream).to_string();
+                break;
+            default:
+                throw std::runtime_error("Binary log contains an argument of unknown type '"s + static_cast<char>(type) + "'");
+        }
+    }
+
+    bool BinaryLogReader::next(BinaryLogRecord& record) {
+        char tag;
+
+        while(file_input_stream.get(tag)) {
+            if(tag == BinaryLogger::FORMAT_DEFINITION_TAG) {
+                read_format_definition();
+                continue;
+            }
+
+            if(tag != BinaryLogger::RECORD_TAG)
+                throw std::runtime_error("Binary log contains an entry with unknown tag '"s + tag + "'");
+
+            auto format_id = read_binary_integer<uint32_t>(file_input_stream);
+            auto format = formats.find(format_id);
+            if(format == formats.end())
+                throw std::runtime_error("Binary log contains a record of undefined format #"s + std::to_string(format_id));
+
+            auto timestamp = read_binary_integer<uint64_t>(file_input_stream);
+            auto argument_count = read_binary_integer<uint8_t>(file_input_stream);
+
+            record.severity = format->second.severity;
+            record.level_tag = format->second.level_tag;
+            record.timestamp = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(timestamp)));
+            record.preformatted = format->second.preformatted;
+            record.message.clear();
+
+            std::string_view format_string = format->second.format;
+            for(uint8_t argument = 0; argument < argument_count; argument++) {
+                auto placeholder = format_string.find(BinaryLogger::ARGUMENT_PLACEHOLDER);
+                record.message.append(format_string.substr(0, placeholder));
+
+                if(placeholder == std::string_view::npos) {
+                    record.message += ' ';
+                    format_string = {};
+                } else {
+                    format_string.remove_prefix(placeholder + BinaryLogger::ARGUMENT_PLACEHOLDER.size());
+                }
+
+                read_argument(record.message);
+            }
+
+            record.message.append(format_string);
+            return true;
+        }
+
+        return false;
+    }
+
+    std::string BinaryLogReader::render(const BinaryLogRecord& record, const MessageFormatter& formatter) {
+        if(record.preformatted)
+            return record.message;
+
+        return formatter.format(record.message, LogLevel::with_borrowed_tag(record.level_tag, record.severity), record.timestamp);
+    }
+}
@@ -0,0 +1,251 @@
+/*
+ * -----------------------------------------------
+ * Binary Logger
+ * -----------------------------------------------
+ * Logs records without formatting them: a record
+ * is an id of a static format string and the raw
+ * bytes of its arguments. Format strings are written
+ * to the log once, the first time they are used,
+ * so the log can be decoded offline by the reader
+ * below or by the 'oop-logcat' tool.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "logger.h++"
+#include "bigint.h++"
+#include <utils/binary_io.h++>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Logs a record of a static format, where every '{}' is replaced by the next argument.
+ * The format is registered once per call site, and the arguments are not evaluated
+ * if the level is disabled. Arguments can be integers, floating point numbers,
+ * strings and big integers.
+ */
+#define OOP_BINARY_LOG(LOGGER, LEVEL, FORMAT, ...) do { \
+    if constexpr((LEVEL).is_compiled_in()) { \
+        static const auto oop_binary_log_format_id = PROJECT_NAME::BinaryLogger::register_format(FORMAT, LEVEL); \
+        if((LOGGER).is_enabled(LEVEL)) \
+            (LOGGER).log_binary(oop_binary_log_format_id __VA_OPT__(,) __VA_ARGS__); \
+    } \
+} while(false)
+
+namespace PROJECT_NAME {
+    enum class BinaryLogArgumentType : uint8_t {
+        SIGNED_INTEGER = 'i',
+        UNSIGNED_INTEGER = 'u',
+        FLOATING_POINT = 'f',
+        STRING = 's',
+        BIG_INTEGER = 'b'
+    };
+
+    struct BinaryLogFormat {
+        unsigned int severity = 0;
+        std::string level_tag;
+        std::string format;
+        bool preformatted = false;
+    };
+
+    struct BinaryLogRecord {
+        unsigned int severity = 0;
+        std::string level_tag;
+        std::chrono::system_clock::time_point timestamp;
+        std::string message;
+        bool preformatted = false;
+    };
+
+    class BinaryLogger : public AbstractLogger {
+    public:
+        using FormatId = uint32_t;
+
+        static constexpr std::string_view FILE_SIGNATURE = "OOPBLOG";
+        static constexpr uint8_t FILE_VERSION = 1;
+        static constexpr char FORMAT_DEFINITION_TAG = 'F';
+        static constexpr char RECORD_TAG = 'R';
+        static constexpr size_t MAX_ARGUMENT_COUNT = UINT8_MAX;
+        static constexpr std::string_view ARGUMENT_PLACEHOLDER = "{}";
+    private:
+        std::ofstream file_output_stream;
+        std::string buffer;
+        size_t buffer_size;
+        std::vector<bool> defined_formats;
+        std::mutex buffer_mutex;
+
+        static std::vector<BinaryLogFormat>& get_formats();
+
+        static std::mutex& get_formats_mutex();
+
+        static FormatId register_format(std::string_view format, LogLevel level, bool preformatted);
+
+        /**
+         * Appends the record header, defining the format before it if it is not defined in this log yet.
+         * The buffer mutex should be locked.
+         *
+         * @param format_id The record format id
+         * @param argument_count A count of the record arguments, stored in a single byte
+         */
+        void begin_record(FormatId format_id, uint8_t argument_count);
+
+        /**
+         * Writes the buffer to the file if it is full. The buffer mutex should be locked.
+         */
+        void end_record();
+
+        void write_buffer();
+
+        static void append_argument(std::string& buffer, const bigint& value) {
+            buffer.push_back(static_cast<char>(BinaryLogArgumentType::BIG_INTEGER));
+            value.write_binary(buffer);
+        }
+
+        template<typename T>
+        requires std::is_integral_v<T> && std::is_signed_v<T>
+        static void append_argument(std::string& buffer, T value) {
+            buffer.push_back(static_cast<char>(BinaryLogArgumentType::SIGNED_INTEGER));
+            append_binary_integer<uint64_t>(buffer, static_cast<uint64_t>(static_cast<int64_t>(value)));
+        }
+
+        template<typename T>
+        requires std::is_integral_v<T> && std::is_unsigned_v<T>
+        static void append_argument(std::string& buffer, T value) {
+            buffer.push_back(static_cast<char>(BinaryLogArgumentType::UNSIGNED_INTEGER));
+            append_binary_integer<uint64_t>(buffer, static_cast<uint64_t>(value));
+        }
+
+        template<typename T>
+        requires std::is_floating_point_v<T>
+        static void append_argument(std::string& buffer, T value) {
+            buffer.push_back(static_cast<char>(BinaryLogArgumentType::FLOATING_POINT));
+            append_binary_integer<uint64_t>(buffer, std::bit_cast<uint64_t>(static_cast<double>(value)));
+        }
+
+        template<typename T>
+        requires std::is_convertible_v<const T&, std::string_view>
+        static void append_argument(std::string& buffer, const T& value) {
+            std::string_view string = value;
+            buffer.push_back(static_cast<char>(BinaryLogArgumentType::STRING));
+            append_binary_integer<uint32_t>(buffer, string.size());
+            buffer.append(string);
+        }
+    public:
+        /**
+         * Registers a static format string and returns its id. Registering
+         * the same format and level again returns the same id.
+         *
+         * @param format The format, where every '{}' is replaced by the next argument
+         * @param level The level of the records of this format
+         * @return The format id
+         */
+        static FormatId register_format(std::string_view format, LogLevel level);
+
+        /**
+         * Creates a new binary logger, replacing the file.
+         *
+         * @throws std::runtime_error When the file cannot be opened
+         * @param logger_filename The file where the binary log will be written to
+         * @param buffer_size A size of the buffer records are collected in before writing
+         */
+        explicit BinaryLogger(const std::string& logger_filename, size_t buffer_size = 1 << 16);
+
+        BinaryLogger(const BinaryLogger&) = delete;
+        BinaryLogger& operator=(const BinaryLogger&) = delete;
+
+        ~BinaryLogger() override;
+
+        /**
+         * Logs a record of a registered format. Prefer the OOP_BINARY_LOG macro,
+         * which registers the format and checks the level.
+         *
+         * @param format_id The format id returned by register_format()
+         * @param arguments The arguments of the format
+         */
+        template<typename... Arguments>
+        void log_binary(FormatId format_id, const Arguments&... arguments) {
+            static_assert(sizeof...(Arguments) <= MAX_ARGUMENT_COUNT, "A binary log record cannot have more than 255 arguments");
+
+            std::lock_guard lock { buffer_mutex };
+            begin_record(format_id, sizeof...(Arguments));
+            (append_argument(buffer, arguments), ...);
+            end_record();
+        }
+
+        /**
+         * Logs a text message as a record with a single string argument.
+         * The formats of the built-in levels are registered once, so they are not looked up.
+         *
+         * @param message The message
+         * @param level The log level
+         */
+        void log(const std::string& message, LogLevel level = INFO) override;
+
+        /**
+         * Logs an already formatted message, which is decoded as it is.
+         *
+         * @param formatted_message The formatted message
+         */
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Writes the buffered records to the file.
+         */
+        void flush() override;
+    };
+
+    class BinaryLogReader {
+        std::ifstream file_input_stream;
+        std::map<BinaryLogger::FormatId, BinaryLogFormat> formats;
+
+        void read_format_definition();
+
+        [[nodiscard]]
+        std::string read_string();
+
+        /**
+         * Reads an argument and appends its text to the message.
+         *
+         * @throws std::runtime_error When the argument is malformed
+         * @param message The message
+         */
+        void read_argument(std::string& message);
+    public:
+        /**
+         * Opens a binary log written by BinaryLogger.
+         *
+         * @throws std::runtime_error When the file cannot be opened or is not a binary log
+         * @param log_filename The binary log file
+         */
+        explicit BinaryLogReader(const std::string& log_filename);
+
+        /**
+         * Reads the next record, substituting its arguments to its format.
+         *
+         * @throws std::runtime_error When the log is truncated or malformed
+         * @param record The variable the record will be read to
+         * @return True if a record was read, false if the log is over
+         */
+        bool next(BinaryLogRecord& record);
+
+        /**
+         * Renders a record as a text logger with the formatter would have written it.
+         *
+         * @param record The record
+         * @param formatter The message formatter
+         * @return The formatted message
+         */
+        [[nodiscard]]
+        static std::string render(const BinaryLogRecord& record, const MessageFormatter& formatter);
+    };
+}
@@ -0,0 +1,101 @@
+#include <command_history.h++>
+#include <stdexcept>
+
+namespace PROJECT_NAME {
+    CommandHistory::CommandHistory(size_t max_depth, size_t snapshot_interval) : max_depth(max_depth), snapshot_interval(snapshot_interval) {
+        if(max_depth == 0 || snapshot_interval == 0) {
+            throw std::invalid_argument("Command history should have positive depth and snapshot interval, but they are set to "s + std::to_string(max_depth) + " and " + std::to_string(snapshot_interval));
+        }
+    }
+
+    void CommandHistory::apply(const Step& step, bigint& value, const OperationRegistry& operations) {
+        if(step.operation == OperationRegistry::UNKNOWN_OPERATION) {
+            value = step.operand;
+        } else {
+            operations.invoke(step.operation, value, step.operand);
+        }
+    }
+
+    void CommandHistory::record(OperationRegistry::OperationId operation, const bigint& operand, const bigint& value_before, const OperationRegistry& operations) {
+        size_t position = first_position + applied_steps_count;
+
+        steps.resize(applied_steps_count);
+        while(!snapshots.empty() && snapshots.back().position > position) {
+            snapshots.pop_back();
+        }
+
+        if(snapshots.empty() || (position % snapshot_interval == 0 && snapshots.back().position != position)) {
+            snapshots.push_back({ position, value_before });
+        }
+
+        steps.push_back({ operation, operand });
+        applied_steps_count++;
+
+        if(steps.size() > max_depth) {
+            Step forgotten_step = std::move(steps.front());
+            steps.pop_front();
+            first_position++;
+            applied_steps_count--;
+
+            if(snapshots.size() > 1 && snapshots[1].position == first_position) {
+                snapshots.pop_front();
+            } else {
+                apply(forgotten_step, snapshots.front().value, operations);
+                snapshots.front().position = first_position;
+            }
+        }
+    }
+
+    bool CommandHistory::undo(bigint& value, const OperationRegistry& operations) {
+        if(applied_steps_count == 0)
+            return false;
+
+        const Step& undone_step = steps[applied_steps_count - 1];
+        auto inverse_operation = operations.get_inverse(undone_step.operation);
+
+        if(inverse_operation != OperationRegistry::UNKNOWN_OPERATION) {
+            operations.invoke(inverse_operation, value, undone_step.operand);
+        } else {
+            size_t target_position = first_position + applied_steps_count - 1;
+            auto snapshot = snapshots.rbegin();
+            while(snapshot->position > target_position) {
+                snapshot++;
+            }
+
+            value = snapshot->value;
+            for(size_t position = snapshot->position; position < target_position; position++) {
+                apply(steps[position - first_position], value, operations);
+            }
+        }
+
+        applied_steps_count--;
+        return true;
+    }
+
+    bool CommandHistory::redo(bigint& value, const OperationRegistry& operations) {
+        if(applied_steps_count == steps.size())
+            return false;
+
+        apply(steps[applied_steps_count], value, operations);
+        applied_steps_count++;
+        return true;
+    }
+
+    void CommandHistory::clear() {
+        steps.clear();
+        snapshots.clear();
+        applied_steps_count = 0;
+    }
+
+    size_t CommandHistory::get_undoable_count() const {
+        return applied_steps_count;
+    }
+
+    size_t CommandHistory::get_redoable_count() const {
+        return steps.size() - applied_steps_count;
+    }
+
+    size_t CommandHistory::get_snapshot_count() const {
+        return snapshots.size();
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * -----------------------------------------------
+ * Command History
+ * -----------------------------------------------
+ * Keeps the undo/redo history of the big integer
+ * command executor. Operations with an inverse
+ * (ADD and SUB) are reverted by applying it, the
+ * rest are reverted by restoring the nearest
+ * periodic snapshot and replaying the steps after
+ * it, so the history never stores a full copy of
+ * the result per step.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "bigint.h++"
+#include "operation_registry.h++"
+#include <deque>
+
+namespace PROJECT_NAME {
+    class CommandHistory {
+        struct Step {
+            OperationRegistry::OperationId operation;
+            bigint operand;
+        };
+
+        struct Snapshot {
+            size_t position;
+            bigint value;
+        };
+
+        std::deque<Step> steps;
+        std::deque<Snapshot> snapshots;
+        size_t first_position = 0, applied_steps_count = 0;
+        size_t max_depth, snapshot_interval;
+
+        static void apply(const Step& step, bigint& value, const OperationRegistry& operations);
+    public:
+        /**
+         * Creates a new command history.
+         *
+         * @param max_depth A maximal count of steps kept, the oldest ones are forgotten
+         * @param snapshot_interval A count of steps between snapshots of the result
+         */
+        explicit CommandHistory(size_t max_depth = 1024, size_t snapshot_interval = 64);
+
+        /**
+         * Records a step right before it is applied. Steps undone before are
+         * no longer redoable after that. A step with UNKNOWN_OPERATION assigns
+         * the operand to the value instead of applying an operation.
+         *
+         * @param operation The operation id
+         * @param operand The operand
+         * @param value_before The result before the operation is applied
+         * @param operations The registry the operation is registered in
+         */
+        void record(OperationRegistry::OperationId operation, const bigint& operand, const bigint& value_before, const OperationRegistry& operations);
+
+        /**
+         * Reverts the last applied step.
+         *
+         * @param value The result the step was applied to
+         * @param operations The registry the step operations are registered in
+         * @return True if a step was reverted, false if there is nothing to undo
+         */
+        bool undo(bigint& value, const OperationRegistry& operations);
+
+        /**
+         * Applies the last reverted step again.
+         *
+         * @param value The result the step will be applied to
+         * @param operations The registry the step operations are registered in
+         * @return True if a step was applied, false if there is nothing to redo
+         */
+        bool redo(bigint& value, const OperationRegistry& operations);
+
+        /**
+         * Forgets all the steps and snapshots.
+         */
+        void clear();
+
+        [[nodiscard]]
+        size_t get_undoable_count() const;
+
+        [[nodiscard]]
+        size_t get_redoable_count() const;
+
+        [[nodiscard]]
+        size_t get_snapshot_count() const;
+    };
+}
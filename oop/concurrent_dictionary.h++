@@ -0,0 +1,304 @@
+/*
+ * -----------------------------------------------
+ * Concurrent Dictionary
+ * -----------------------------------------------
+ * A dictionary shared by many threads. Keys are
+ * spread over shards, every shard is an immutable
+ * Dictionary snapshot replaced on write under the
+ * shard lock. Readers never lock: they announce
+ * themselves in striped counters, and replaced
+ * snapshots are deleted only after every reader
+ * that could see them has left. Writes copy the
+ * whole shard, so it suits read-mostly tables.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "dictionary.h++"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace PROJECT_NAME {
+    /**
+     * Points of the read path of a concurrent dictionary where races can happen.
+     * These hooks do nothing and are compiled out, tests pass their own ones to
+     * pause readers at these points.
+     */
+    struct ConcurrentDictionaryHooks {
+        /**
+         * Called by readers after they read the epoch, before they announce themselves.
+         */
+        static void on_epoch_read() {
+            //
+        }
+    };
+
+    template<typename K, typename V, typename Hash = DictionaryHash<K>, typename Hooks = ConcurrentDictionaryHooks>
+    class ConcurrentDictionary {
+        using Key = K;
+        using Value = V;
+        using Snapshot = Dictionary<Key, Value, Hash>;
+
+        static constexpr size_t READER_STRIPE_COUNT = 64;
+        static constexpr size_t RECLAMATION_THRESHOLD = 64;
+
+        struct alignas(64) Shard {
+            std::atomic<const Snapshot*> snapshot = new Snapshot();
+            std::mutex writing_mutex;
+            std::vector<const Snapshot*> retired_snapshots;
+        };
+
+        struct alignas(64) ReaderStripe {
+            std::array<std::atomic<unsigned long long>, 2> active_readers {};
+        };
+
+        /**
+         * Marks the calling thread as a reader of the current epoch
+         * until it is destroyed. Snapshots a reader has seen are not
+         * deleted while it is active.
+         */
+        class ReadSection {
+            std::atomic<unsigned long long>* active_readers;
+        public:
+            /**
+             * Announces the reader in the counter of the epoch parity. If a writer starts a new
+             * epoch between reading the epoch and announcing, the writer may have already checked
+             * that counter, so the reader leaves it and announces itself again in the new one.
+             * Only the announcement and the second epoch read are sequentially consistent, as
+             * the writer should see the announcement or the reader should see the new epoch.
+             */
+            explicit ReadSection(const ConcurrentDictionary& dictionary) {
+                auto& reader_stripe = dictionary.reader_stripes[get_reader_stripe_index()];
+                auto epoch_parity = dictionary.epoch.load(std::memory_order_relaxed) & 1;
+
+                while(true) {
+                    Hooks::on_epoch_read();
+
+                    active_readers = &reader_stripe.active_readers[epoch_parity];
+                    active_readers->fetch_add(1);
+
+                    auto current_epoch_parity = dictionary.epoch.load() & 1;
+                    if(current_epoch_parity == epoch_parity)
+                        break;
+
+                    active_readers->fetch_sub(1, std::memory_order_release);
+                    epoch_parity = current_epoch_parity;
+                }
+            }
+
+            ReadSection(const ReadSection&) = delete;
+            ReadSection& operator=(const ReadSection&) = delete;
+
+            ~ReadSection() {
+                active_readers->fetch_sub(1, std::memory_order_release);
+            }
+        };
+
+        std::unique_ptr<Shard[]> shards;
+        unsigned int shard_count_bits;
+        mutable std::array<ReaderStripe, READER_STRIPE_COUNT> reader_stripes;
+        std::atomic<unsigned long long> epoch = 0;
+        std::atomic<size_t> retired_snapshot_count = 0;
+        std::mutex reclamation_mutex;
+
+        static size_t get_reader_stripe_index() {
+            static std::atomic<size_t> next_reader_stripe_index = 0;
+            thread_local size_t reader_stripe_index = READER_STRIPE_COUNT;
+
+            if(reader_stripe_index == READER_STRIPE_COUNT) [[unlikely]]
+                reader_stripe_index = next_reader_stripe_index.fetch_add(1, std::memory_order_relaxed) % READER_STRIPE_COUNT;
+
+            return reader_stripe_index;
+        }
+
+        /**
+         * Returns the shard of the key hash. The low bits of the hash choose the shard,
+         * and the high ones choose the slot in the shard Dictionary.
+         */
+        [[nodiscard]]
+        Shard& get_shard(uint64_t hash) const {
+            return shards[hash & ((size_t { 1 } << shard_count_bits) - 1)];
+        }
+
+        /**
+         * Starts a new epoch and waits until the readers of the previous one leave.
+         * Readers that start after the epoch changes see only the published snapshots.
+         * Grace periods should not overlap, so it is called under the reclamation lock.
+         */
+        void wait_for_readers() {
+            auto previous_epoch_parity = epoch.fetch_add(1) & 1;
+
+            for(auto& reader_stripe : reader_stripes) {
+                while(reader_stripe.active_readers[previous_epoch_parity].load() != 0)
+                    std::this_thread::yield();
+            }
+        }
+
+        /**
+         * Deletes the snapshots retired by all the shards once enough of them are retired.
+         * Shard locks are taken only to collect the snapshots, so the writers of other shards
+         * are not blocked by the grace period. If another writer is reclaiming at the moment,
+         * the snapshots are left to the next write.
+         */
+        void reclaim() {
+            std::unique_lock lock { reclamation_mutex, std::try_to_lock };
+            if(!lock.owns_lock() || retired_snapshot_count.load(std::memory_order_relaxed) < RECLAMATION_THRESHOLD)
+                return;
+
+            std::vector<const Snapshot*> reclaimed_snapshots;
+            for(size_t shard_index = 0; shard_index < (size_t { 1 } << shard_count_bits); shard_index++) {
+                auto& shard = shards[shard_index];
+                std::lock_guard shard_lock { shard.writing_mutex };
+                reclaimed_snapshots.insert(reclaimed_snapshots.end(), shard.retired_snapshots.begin(), shard.retired_snapshots.end());
+                shard.retired_snapshots.clear();
+            }
+
+            retired_snapshot_count.fetch_sub(reclaimed_snapshots.size(), std::memory_order_relaxed);
+
+            wait_for_readers();
+            for(const auto* reclaimed_snapshot : reclaimed_snapshots)
+                delete reclaimed_snapshot;
+        }
+    public:
+        /**
+         * Creates an empty concurrent dictionary.
+         * @param shard_count A count of shards, rounded up to a power of two
+         */
+        explicit ConcurrentDictionary(size_t shard_count = 64)
+            : shard_count_bits(std::bit_width(std::max<size_t>(shard_count, 1) - 1)) {
+            shards = std::make_unique<Shard[]>(size_t { 1 } << shard_count_bits);
+        }
+
+        ConcurrentDictionary(const ConcurrentDictionary&) = delete;
+        ConcurrentDictionary& operator=(const ConcurrentDictionary&) = delete;
+
+        /**
+         * Deletes the snapshots. No thread should use the dictionary anymore.
+         */
+        ~ConcurrentDictionary() {
+            for(size_t shard_index = 0; shard_index < (size_t { 1 } << shard_count_bits); shard_index++) {
+                delete shards[shard_index].snapshot.load();
+
+                for(const auto* retired_snapshot : shards[shard_index].retired_snapshots)
+                    delete retired_snapshot;
+            }
+        }
+
+        /**
+         * Puts the value, copying the shard of the key, so a write takes time
+         * proportional to the shard size. It locks only that shard, and the readers
+         * see either the old shard or the new one.
+         *
+         * @param key The key
+         * @param value The value
+         */
+        void put(const Key& key, Value value) {
+            auto& shard = get_shard(Snapshot::hash_key(key));
+
+            {
+                std::lock_guard lock { shard.writing_mutex };
+                const auto* previous_snapshot = shard.snapshot.load(std::memory_order_relaxed);
+
+                auto* snapshot = new Snapshot(*previous_snapshot);
+                snapshot->put(key, std::move(value));
+                shard.snapshot.store(snapshot, std::memory_order_release);
+                shard.retired_snapshots.push_back(previous_snapshot);
+            }
+
+            if(retired_snapshot_count.fetch_add(1, std::memory_order_relaxed) + 1 >= RECLAMATION_THRESHOLD)
+                reclaim();
+        }
+
+        /**
+         * Calls the function with the value of the key without locking or copying the value.
+         * The value should not be used after the function returns, and the function
+         * should not write to this dictionary.
+         *
+         * @param key The key, or anything comparable to it and hashed the same way
+         * @param function The function accepting a constant reference to the value
+         * @return True if the key is present and the function was called
+         */
+        template<typename LookupKey, typename Function>
+        bool visit(const LookupKey& key, Function&& function) const {
+            auto hash = Snapshot::hash_key(key);
+            ReadSection read_section { *this };
+
+            if(const auto* value = get_shard(hash).snapshot.load(std::memory_order_acquire)->find(key, hash)) {
+                function(*value);
+                return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * Returns a copy of the value of the key without locking or throwing.
+         *
+         * @param key The key, or anything comparable to it and hashed the same way
+         * @return The value, or nothing if the key is not present
+         */
+        template<typename LookupKey = Key>
+        [[nodiscard]]
+        std::optional<Value> try_get(const LookupKey& key) const {
+            auto hash = Snapshot::hash_key(key);
+            ReadSection read_section { *this };
+
+            if(const auto* value = get_shard(hash).snapshot.load(std::memory_order_acquire)->find(key, hash))
+                return *value;
+
+            return std::nullopt;
+        }
+
+        /**
+         * Returns a copy of the value of the key without locking.
+         *
+         * @throws std::runtime_error When the key is not present
+         * @param key The key, or anything comparable to it and hashed the same way
+         * @return The value
+         */
+        template<typename LookupKey = Key>
+        [[nodiscard]]
+        Value get(const LookupKey& key) const {
+            if(auto value = try_get(key))
+                return std::move(*value);
+
+            throw std::runtime_error("Trying to get value from dictionary by key, which is not present.");
+        }
+
+        template<typename LookupKey = Key>
+        [[nodiscard]]
+        bool has(const LookupKey& key) const {
+            auto hash = Snapshot::hash_key(key);
+            ReadSection read_section { *this };
+            return get_shard(hash).snapshot.load(std::memory_order_acquire)->find(key, hash) != nullptr;
+        }
+
+        /**
+         * Returns a count of pairs. It is not atomic across the shards,
+         * so the count may be stale if other threads are writing.
+         *
+         * @return The count of pairs
+         */
+        [[nodiscard]]
+        size_t size() const {
+            ReadSection read_section { *this };
+
+            size_t pair_count = 0;
+            for(size_t shard_index = 0; shard_index < (size_t { 1 } << shard_count_bits); shard_index++)
+                pair_count += shards[shard_index].snapshot.load(std::memory_order_acquire)->size();
+
+            return pair_count;
+        }
+    };
+}
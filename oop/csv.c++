@@ -1,50 +1,111 @@
 #include <csv.h++>
+#include <unordered_map>
 
 namespace PROJECT_NAME {
-    CSV::CSV(char delimiter, char grouper) : delimiter(delimiter), grouper(grouper) {
-        if(delimiter == grouper) {
-            throw std::invalid_argument("CSV parser should have different delimiter and group, but all of them is set to character: '"s + delimiter + "'");
+    CSVRowStream::CSVRowStream(std::istream& stream, char delimiter, char grouper) : stream(&stream), grouper(grouper), scanner(delimiter, grouper) {
+        //
+    }
+
+    CSVRowStream::CSVRowStream(std::unique_ptr<std::istream> stream, char delimiter, char grouper)
+        : owned_stream(std::move(stream)), stream(owned_stream.get()), grouper(grouper), scanner(delimiter, grouper) {
+        //
+    }
+
+    bool CSVRowStream::next_separator(size_t& separator) {
+        while(separator_index == separators.size()) {
+            if(stream_is_over)
+                return false;
+
+            buffer.erase(0, row_start);
+            cell_start -= row_start;
+            row_start = 0;
+            separators.clear();
+            separator_index = 0;
+
+            auto scanned_size = buffer.size();
+            buffer.resize(scanned_size + CHUNK_SIZE);
+            stream->read(buffer.data() + scanned_size, CHUNK_SIZE);
+            auto chunk_size = static_cast<size_t>(stream->gcount());
+            buffer.resize(scanned_size + chunk_size);
+
+            if(chunk_size == 0) {
+                stream_is_over = true;
+                return false;
+            }
+
+            scanner.scan({ buffer.data() + scanned_size, chunk_size }, scanned_size, separators);
         }
+
+        separator = separators[separator_index++];
+        return true;
     }
 
-    [[nodiscard]]
-    std::vector<std::vector<std::string>> CSV::parse(const std::string& raw_csv) const {
-        std::vector<std::vector<std::string>> csv_table;
+    void CSVRowStream::end_cell(std::vector<std::string>& row, size_t cell_end, bool row_is_over) {
+        std::string_view raw_cell { buffer.data() + cell_start, cell_end - cell_start };
+        cell_start = cell_end + 1;
 
-        if(raw_csv.empty() || raw_csv == "\n")
-            return csv_table;
+        if(row_is_over && raw_cell.empty())
+            return;
 
-        for(auto& line : split_string(raw_csv, "\n")) {
-            if(line.empty() || line == "\n")
-                continue;
+        if(raw_cell.find(grouper) == std::string_view::npos) {
+            row.emplace_back(raw_cell);
+            return;
+        }
 
-            std::vector<std::string> csv_table_row;
-            std::stringstream csv_table_cell;
-
-            bool in_group = false;
-
-            for(const auto& character : line) {
-                if(character == delimiter && !in_group) {
-                    csv_table_row.push_back(csv_table_cell.str());
-                    csv_table_cell.str({});
-                    csv_table_cell.clear();
-                } else if(character == grouper) {
-                    in_group = !in_group;
-                } else {
-                    csv_table_cell << character;
-                }
-            }
+        CSVScanner::unescape(raw_cell, grouper, row.emplace_back());
+    }
 
-            if(in_group) {
-                throw std::runtime_error("CSV table row '"s + line + "' has unclosed group character. Please, add character '" + grouper + "' to close it.");
+    bool CSVRowStream::next(std::vector<std::string>& row) {
+        row.clear();
+        size_t separator;
+
+        while(next_separator(separator)) {
+            if(buffer[separator] != '\n') {
+                end_cell(row, separator, false);
+                continue;
             }
 
-            if(!csv_table_cell.str().empty()) {
-                csv_table_row.push_back(csv_table_cell.str());
-                csv_table_cell.str({});
-                csv_table_cell.clear();
+            if(separator == row_start) {
+                row_start = cell_start = separator + 1;
+                continue;
             }
 
+            end_cell(row, separator, true);
+            row_start = cell_start;
+            return true;
+        }
+
+        if(scanner.is_in_group())
+            throw std::runtime_error("CSV table ends inside a group. Please, add character '"s + grouper + "' to close it.");
+
+        if(row_start == buffer.size())
+            return false;
+
+        end_cell(row, buffer.size(), true);
+        row_start = cell_start = buffer.size();
+        return true;
+    }
+
+    CSVRowStream::iterator CSVRowStream::begin() {
+        return iterator(this);
+    }
+
+    std::default_sentinel_t CSVRowStream::end() {
+        return std::default_sentinel;
+    }
+
+    CSV::CSV(char delimiter, char grouper) : delimiter(delimiter), grouper(grouper) {
+        if(delimiter == grouper) {
+            throw std::invalid_argument("CSV parser should have different delimiter and group, but all of them is set to character: '"s + delimiter + "'");
+        }
+    }
+
+    [[nodiscard]]
+    std::vector<std::vector<std::string>> CSV::parse(const std::string& raw_csv) const {
+        std::vector<std::vector<std::string>> csv_table;
+        std::istringstream csv_input_stream { raw_csv };
+
+        for(const auto& csv_table_row : rows(csv_input_stream)) {
             csv_table.push_back(csv_table_row);
         }
 
@@ -61,31 +122,109 @@ namespace PROJECT_NAME {
             }
         }
 
-        std::fstream csv_input_file {filename };
+        std::vector<std::vector<std::string>> csv_table;
+        for(const auto& csv_table_row : stream(filename)) {
+            csv_table.push_back(csv_table_row);
+        }
+
+        return csv_table;
+    }
+
+    CSVRowStream CSV::rows(std::istream& stream) const {
+        return { stream, delimiter, grouper };
+    }
 
-        if(!csv_input_file.is_open())
+    CSVRowStream CSV::stream(const std::string& filename) const {
+        auto csv_input_file = std::make_unique<std::ifstream>(filename, std::ios::binary);
+
+        if(!csv_input_file->is_open())
             throw std::runtime_error("Cannot open file '"s + filename + "' for reading CSV table for some reason");
 
-        std::string csv_file_content((std::istreambuf_iterator<char>(csv_input_file)),
-                                     std::istreambuf_iterator<char>());
+        return { std::move(csv_input_file), delimiter, grouper };
+    }
+
+    CSVDocument CSV::map_file(const std::string& filename) const {
+        return CSVDocument { filename, delimiter, grouper };
+    }
+
+    CSVDocument CSV::map_file(const std::string& filename, ThreadPool& thread_pool) const {
+        return CSVDocument { filename, thread_pool, delimiter, grouper };
+    }
+
+    std::vector<std::vector<std::string>> CSV::parse_file(const std::string& filename, ThreadPool& thread_pool) const {
+        auto csv_document = map_file(filename, thread_pool);
+        std::vector<std::vector<std::string>> csv_table(csv_document.size());
+
+        thread_pool.parallel_for(csv_document.get_chunk_count(), [&](size_t chunk_index) {
+            for(auto row_index = csv_document.get_chunk_first_row(chunk_index); row_index < csv_document.get_chunk_first_row(chunk_index + 1); row_index++) {
+                auto row = csv_document[row_index];
+                csv_table[row_index].assign(row.begin(), row.end());
+            }
+        });
+
+        return csv_table;
+    }
+
+    CSVColumns CSV::load_columns(const std::string& filename, const std::vector<CSVColumnDefinition>& schema) const {
+        return { map_file(filename), schema };
+    }
+
+    CSVColumns CSV::load_columns(const std::string& filename, const std::vector<CSVColumnDefinition>& schema, ThreadPool& thread_pool) const {
+        return { map_file(filename, thread_pool), schema, &thread_pool };
+    }
+
+    void CSV::parse_file(const std::string& filename, ThreadPool& thread_pool, const std::function<void(size_t, std::vector<std::vector<std::string>>&)>& chunk_callback) const {
+        auto csv_document = map_file(filename, thread_pool);
+
+        thread_pool.parallel_for(csv_document.get_chunk_count(), [&](size_t chunk_index) {
+            auto rows = csv_document.to_table(csv_document.get_chunk_first_row(chunk_index), csv_document.get_chunk_first_row(chunk_index + 1));
+            chunk_callback(chunk_index, rows);
+        });
+    }
 
-        return parse(csv_file_content);
+    CSVWriter CSV::writer(const std::string& filename, CSVWriteMode mode) const {
+        return CSVWriter { filename, mode, delimiter, grouper };
     }
 
     void CSV::export_file(const std::string& filename, const std::vector<std::vector<std::string>>& csv_table) const {
-        std::fstream csv_output_file { filename };
+        auto csv_writer = writer(filename, CSVWriteMode::ATOMIC_REPLACE);
+        csv_writer.write_rows(csv_table);
+        csv_writer.close();
+    }
+
+    void CSV::append_row(const std::string& filename, const std::vector<std::string>& row) const {
+        auto csv_writer = writer(filename, CSVWriteMode::APPEND);
+        csv_writer.write_row(row);
+        csv_writer.sync();
+        csv_writer.close();
+    }
 
-        if(!csv_output_file.is_open())
-            throw std::runtime_error("Cannot open file '"s + filename + "' for writing CSV table for some reason");
+    size_t CSV::compact_file(const std::string& filename, size_t key_column) const {
+        auto csv_document = map_file(filename);
+        std::unordered_map<std::string_view, size_t> last_key_rows;
+
+        for(size_t row_index = 0; row_index < csv_document.size(); row_index++) {
+            auto row = csv_document[row_index];
+            if(key_column < row.size())
+                last_key_rows[row[key_column]] = row_index;
+        }
 
-        for(const auto& csv_table_row : csv_table) {
-            for(const auto& csv_table_cell : csv_table_row) {
-                csv_output_file << grouper << csv_table_cell << grouper << delimiter;
+        auto csv_writer = writer(filename, CSVWriteMode::ATOMIC_REPLACE);
+        size_t removed_row_count = 0;
+
+        for(size_t row_index = 0; row_index < csv_document.size(); row_index++) {
+            auto row = csv_document[row_index];
+
+            if(key_column < row.size() && last_key_rows[row[key_column]] != row_index) {
+                removed_row_count++;
+                continue;
             }
-            csv_output_file << '\n';
+
+            csv_writer.write_row(row);
         }
 
-        csv_output_file.close();
+        csv_writer.close();
+        return removed_row_count;
     }
 
     [[nodiscard]]
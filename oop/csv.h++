@@ -17,11 +17,126 @@
 #include <filesystem>
 #include <fstream>
 #include <streambuf>
+#include <istream>
+#include <sstream>
+#include <iterator>
+#include <memory>
+#include <functional>
 #include <utils/strings.h++>
+#include "csv_document.h++"
+#include "csv_scanner.h++"
+#include "csv_columns.h++"
+#include "csv_writer.h++"
 
 using namespace std::string_literals;
 
 namespace PROJECT_NAME {
+    class CSVRowStream {
+        static constexpr size_t CHUNK_SIZE = 64 << 10;
+
+        std::unique_ptr<std::istream> owned_stream;
+        std::istream* stream;
+        char grouper;
+        CSVScanner scanner;
+        std::string buffer;
+        std::vector<size_t> separators;
+        size_t separator_index = 0, row_start = 0, cell_start = 0;
+        bool stream_is_over = false;
+
+        /**
+         * Finds the next cell separator, reading and scanning the next chunk when the
+         * separators of the current one are over. The buffer keeps the current row only.
+         *
+         * @param separator The variable the separator position in the buffer will be written to
+         * @return True if a separator was found, false if the stream is over
+         */
+        bool next_separator(size_t& separator);
+
+        /**
+         * Appends the cell ending at the position to the row, unless it is an empty last cell without groupers.
+         *
+         * @param row The row the cell is appended to
+         * @param cell_end The position of the cell end in the buffer
+         * @param row_is_over Whether the cell is the last one in the row
+         */
+        void end_cell(std::vector<std::string>& row, size_t cell_end, bool row_is_over);
+    public:
+        class iterator {
+            CSVRowStream* rows = nullptr;
+            std::vector<std::string> row;
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::vector<std::string>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+            iterator() = default;
+
+            explicit iterator(CSVRowStream* rows) : rows(rows) {
+                ++*this;
+            }
+
+            reference operator*() const {
+                return row;
+            }
+
+            pointer operator->() const {
+                return &row;
+            }
+
+            iterator& operator++() {
+                if(!rows->next(row))
+                    rows = nullptr;
+
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            bool operator==(std::default_sentinel_t) const {
+                return rows == nullptr;
+            }
+        };
+
+        /**
+         * Creates a new row stream reading the CSV table from the input stream.
+         * The stream should outlive the row stream.
+         *
+         * @param stream The input stream
+         * @param delimiter The CSV cell delimiter
+         * @param grouper The CSV cell grouper
+         */
+        CSVRowStream(std::istream& stream, char delimiter, char grouper);
+
+        /**
+         * Creates a new row stream owning the input stream.
+         *
+         * @param stream The input stream
+         * @param delimiter The CSV cell delimiter
+         * @param grouper The CSV cell grouper
+         */
+        CSVRowStream(std::unique_ptr<std::istream> stream, char delimiter, char grouper);
+
+        /**
+         * Reads the next row. Rows are split as CSV::parse() splits them, but a group
+         * may contain line breaks, and two groupers in a row inside a group stand
+         * for a single grouper character. Empty lines are skipped, and an empty last
+         * cell is dropped unless it is grouped, like in "lorem,\"\"".
+         *
+         * @throws std::runtime_error When the table ends inside a group
+         * @param row The vector the row cells will be written to
+         * @return True if a row was read, false if the table is over
+         */
+        bool next(std::vector<std::string>& row);
+
+        iterator begin();
+
+        std::default_sentinel_t end();
+    };
+
     class CSV {
         static inline char DEFAULT_DELIMITER = ',', DEFAULT_GROUPER = '"';
         char delimiter, grouper;
@@ -34,7 +149,11 @@ namespace PROJECT_NAME {
         CSV(char delimiter = DEFAULT_DELIMITER, char grouper = DEFAULT_GROUPER);
 
         /**
-         * Parses the CSV table stored in the passed string.
+         * Parses the CSV table stored in the passed string. Groups may contain
+         * line breaks, and two groupers in a row inside a group are a single one.
+         *
+         * @see CSVRowStream::next()
+         * @throws std::runtime_error When the table ends inside a group
          * @param raw_csv Raw CSV table
          * @return The CSV table stored in 2D-vector
          */
@@ -52,12 +171,147 @@ namespace PROJECT_NAME {
         std::vector<std::vector<std::string>> parse_file(const std::string& filename, bool create_file_if_not_exists = false) const;
 
         /**
-         * Writes the CSV table to the file.
+         * Returns a stream of the rows of the CSV table read from the input stream.
+         * The table is read in chunks, so only a single row is kept in memory.
+         *
+         * @see CSVRowStream::next()
+         * @param stream The input stream, which should outlive the returned row stream
+         * @return The row stream, e.g. for a range-based loop
+         */
+        [[nodiscard]]
+        CSVRowStream rows(std::istream& stream) const;
+
+        /**
+         * Returns a stream of the rows of the CSV table stored in the file.
+         *
+         * @see CSVRowStream::next()
+         * @throws std::runtime_error When the file cannot be opened
+         * @param filename The CSV table file
+         * @return The row stream, e.g. for a range-based loop
+         */
+        [[nodiscard]]
+        CSVRowStream stream(const std::string& filename) const;
+
+        /**
+         * Maps the file to memory and parses the CSV table stored in it without copying the cells.
+         *
+         * @see CSVDocument
+         * @throws std::runtime_error When the file cannot be mapped or the table ends inside a group
+         * @param filename The CSV table file
+         * @return The document, which owns the mapping the cells point to
+         */
+        [[nodiscard]]
+        CSVDocument map_file(const std::string& filename) const;
+
+        /**
+         * Maps the file to memory and parses the CSV table stored in it in chunks on the thread pool.
+         *
+         * @see CSVDocument
+         * @throws std::runtime_error When the file cannot be mapped or the table ends inside a group
+         * @param filename The CSV table file
+         * @param thread_pool The thread pool
+         * @return The document, which owns the mapping the cells point to
+         */
+        [[nodiscard]]
+        CSVDocument map_file(const std::string& filename, ThreadPool& thread_pool) const;
+
+        /**
+         * Parses the CSV table stored in the file in chunks on the thread pool.
+         * The result is the same as parse_file() returns.
+         *
+         * @throws std::runtime_error When the file cannot be mapped or the table ends inside a group
+         * @param filename The CSV table file
+         * @param thread_pool The thread pool
+         * @return The CSV table stored in 2D-vector
+         */
+        [[nodiscard]]
+        std::vector<std::vector<std::string>> parse_file(const std::string& filename, ThreadPool& thread_pool) const;
+
+        /**
+         * Parses the CSV table stored in the file in chunks on the thread pool, passing
+         * the rows of every chunk to the callback instead of concatenating them. The callback
+         * is called on the pool threads, possibly at the same time and out of order.
+         *
+         * @throws std::runtime_error When the file cannot be mapped or the table ends inside a group
+         * @throws Any exception thrown by the callback
+         * @param filename The CSV table file
+         * @param thread_pool The thread pool
+         * @param chunk_callback The function accepting the chunk index and its rows, which follow the rows of the previous chunk
+         */
+        void parse_file(const std::string& filename, ThreadPool& thread_pool, const std::function<void(size_t chunk_index, std::vector<std::vector<std::string>>& rows)>& chunk_callback) const;
+
+        /**
+         * Loads the columns listed in the schema from the CSV table stored in the file
+         * into typed contiguous vectors. The other columns are not converted.
+         *
+         * @see CSVColumns
+         * @throws std::runtime_error When the file cannot be mapped, or a cell is missing or cannot be converted
+         * @param filename The CSV table file
+         * @param schema The columns to load and their types
+         * @return The loaded columns, in the schema order
+         */
+        [[nodiscard]]
+        CSVColumns load_columns(const std::string& filename, const std::vector<CSVColumnDefinition>& schema) const;
+
+        /**
+         * Loads the columns listed in the schema from the CSV table stored in the file,
+         * parsing the table in chunks and converting the columns in parallel on the thread pool.
+         *
+         * @see CSVColumns
+         * @throws std::runtime_error When the file cannot be mapped, or a cell is missing or cannot be converted
+         * @param filename The CSV table file
+         * @param schema The columns to load and their types
+         * @param thread_pool The thread pool
+         * @return The loaded columns, in the schema order
+         */
+        [[nodiscard]]
+        CSVColumns load_columns(const std::string& filename, const std::vector<CSVColumnDefinition>& schema, ThreadPool& thread_pool) const;
+
+        /**
+         * Opens a buffered writer of a CSV table with this delimiter and grouper.
+         *
+         * @see CSVWriter
+         * @throws std::runtime_error When the file cannot be opened
+         * @param filename The CSV table file
+         * @param mode How the file is written
+         * @return The writer
+         */
+        [[nodiscard]]
+        CSVWriter writer(const std::string& filename, CSVWriteMode mode = CSVWriteMode::REPLACE) const;
+
+        /**
+         * Writes the CSV table to the file, creating it if it does not exist.
+         * The file is replaced atomically, so readers see either the old table or the new one.
+         *
+         * @throws std::runtime_error When the file cannot be written
          * @param filename The file name, where the CSV table will be written to
          * @param csv_table The CSV table
          */
         void export_file(const std::string& filename, const std::vector<std::vector<std::string>>& csv_table) const;
 
+        /**
+         * Appends a row to the file with a single write and synchronizes the file to the disk,
+         * creating the file if it does not exist. The cost does not depend on the file size,
+         * and rows appended by different processes are not interleaved.
+         *
+         * @throws std::runtime_error When the file cannot be written
+         * @param filename The CSV table file
+         * @param row The row cells
+         */
+        void append_row(const std::string& filename, const std::vector<std::string>& row) const;
+
+        /**
+         * Rewrites the file keeping only the last row of every key, so a table
+         * updated by appending rows can be compacted from time to time.
+         * The file is replaced atomically, but rows appended while it is compacted are lost.
+         *
+         * @throws std::runtime_error When the file cannot be read or written
+         * @param filename The CSV table file
+         * @param key_column The index of the column rows are identified by, rows without it are kept
+         * @return A count of removed rows
+         */
+        size_t compact_file(const std::string& filename, size_t key_column = 0) const;
+
         /**
          * Returns the CSV delimiter of this parser.
          * @return The CSV delimiter
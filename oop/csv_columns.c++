@@ -0,0 +1,176 @@
+#include <csv_columns.h++>
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace PROJECT_NAME {
+    CSVColumn::CSVColumn(const CSVDocument& document, CSVColumnDefinition definition) : definition(definition) {
+        switch(definition.type) {
+            case CSVColumnType::INT64:
+                load_integers(document);
+                break;
+            case CSVColumnType::DOUBLE:
+                load_doubles(document);
+                break;
+            case CSVColumnType::BIGINT:
+                load_bigints(document);
+                break;
+            case CSVColumnType::STRING:
+                load_strings(document);
+                break;
+        }
+    }
+
+    std::string_view CSVColumn::get_cell(const CSVDocument& document, size_t row_index) const {
+        auto row = document[row_index];
+        if(definition.index >= row.size())
+            throw std::runtime_error("Row #"s + std::to_string(row_index) + " of CSV table has " + std::to_string(row.size()) + " cells, so it has no cell in column #" + std::to_string(definition.index));
+
+        return row[definition.index];
+    }
+
+    void CSVColumn::throw_malformed_cell(std::string_view cell, size_t row_index) const {
+        static constexpr const char* TYPE_NAMES[] = { "a 64-bit integer", "a floating point number", "a big integer", "a string" };
+        throw std::runtime_error("Cell '"s + std::string(cell) + "' in row #" + std::to_string(row_index) + " and column #" + std::to_string(definition.index) + " is not " + TYPE_NAMES[static_cast<int>(definition.type)]);
+    }
+
+    void CSVColumn::load_integers(const CSVDocument& document) {
+        std::vector<int64_t> integers(document.size());
+
+        for(size_t row_index = 0; row_index < document.size(); row_index++) {
+            auto cell = get_cell(document, row_index);
+            auto result = std::from_chars(cell.data(), cell.data() + cell.size(), integers[row_index]);
+
+            if(result.ec != std::errc() || result.ptr != cell.data() + cell.size())
+                throw_malformed_cell(cell, row_index);
+        }
+
+        values = std::move(integers);
+    }
+
+    void CSVColumn::load_doubles(const CSVDocument& document) {
+        std::vector<double> doubles(document.size());
+
+        for(size_t row_index = 0; row_index < document.size(); row_index++) {
+            auto cell = get_cell(document, row_index);
+            auto result = std::from_chars(cell.data(), cell.data() + cell.size(), doubles[row_index]);
+
+            if(result.ec != std::errc() || result.ptr != cell.data() + cell.size())
+                throw_malformed_cell(cell, row_index);
+        }
+
+        values = std::move(doubles);
+    }
+
+    void CSVColumn::load_bigints(const CSVDocument& document) {
+        std::vector<bigint> bigints;
+        bigints.reserve(document.size());
+
+        for(size_t row_index = 0; row_index < document.size(); row_index++) {
+            auto cell = get_cell(document, row_index);
+
+            try {
+                bigints.emplace_back(std::string(cell));
+            } catch(const std::invalid_argument&) {
+                throw_malformed_cell(cell, row_index);
+            }
+        }
+
+        values = std::move(bigints);
+    }
+
+    void CSVColumn::load_strings(const CSVDocument& document) {
+        CSVStringColumn strings;
+        std::unordered_map<std::string_view, uint32_t> codes;
+        strings.codes.reserve(document.size());
+
+        for(size_t row_index = 0; row_index < document.size(); row_index++) {
+            auto cell = get_cell(document, row_index);
+            auto [code, inserted] = codes.try_emplace(cell, static_cast<uint32_t>(strings.dictionary.size()));
+
+            if(inserted)
+                strings.dictionary.emplace_back(cell);
+
+            strings.codes.push_back(code->second);
+        }
+
+        values = std::move(strings);
+    }
+
+    size_t CSVColumn::get_index() const {
+        return definition.index;
+    }
+
+    CSVColumnType CSVColumn::get_type() const {
+        return definition.type;
+    }
+
+    size_t CSVColumn::size() const {
+        return std::visit([](const auto& column_values) {
+            if constexpr(std::is_same_v<std::decay_t<decltype(column_values)>, CSVStringColumn>)
+                return column_values.codes.size();
+            else
+                return column_values.size();
+        }, values);
+    }
+
+    const std::vector<int64_t>& CSVColumn::get_integers() const {
+        if(definition.type != CSVColumnType::INT64)
+            throw std::logic_error("Column #"s + std::to_string(definition.index) + " does not contain 64-bit integers");
+
+        return std::get<std::vector<int64_t>>(values);
+    }
+
+    const std::vector<double>& CSVColumn::get_doubles() const {
+        if(definition.type != CSVColumnType::DOUBLE)
+            throw std::logic_error("Column #"s + std::to_string(definition.index) + " does not contain floating point numbers");
+
+        return std::get<std::vector<double>>(values);
+    }
+
+    const std::vector<bigint>& CSVColumn::get_bigints() const {
+        if(definition.type != CSVColumnType::BIGINT)
+            throw std::logic_error("Column #"s + std::to_string(definition.index) + " does not contain big integers");
+
+        return std::get<std::vector<bigint>>(values);
+    }
+
+    const CSVStringColumn& CSVColumn::get_strings() const {
+        if(definition.type != CSVColumnType::STRING)
+            throw std::logic_error("Column #"s + std::to_string(definition.index) + " does not contain strings");
+
+        return std::get<CSVStringColumn>(values);
+    }
+
+    CSVColumns::CSVColumns(const CSVDocument& document, const std::vector<CSVColumnDefinition>& schema, ThreadPool* thread_pool) : row_count(document.size()) {
+        std::vector<std::optional<CSVColumn>> loaded_columns(schema.size());
+        auto load_column = [&](size_t schema_index) {
+            loaded_columns[schema_index].emplace(document, schema[schema_index]);
+        };
+
+        if(thread_pool != nullptr) {
+            thread_pool->parallel_for(schema.size(), load_column);
+        } else {
+            for(size_t schema_index = 0; schema_index < schema.size(); schema_index++)
+                load_column(schema_index);
+        }
+
+        columns.reserve(schema.size());
+        for(auto& column : loaded_columns)
+            columns.push_back(std::move(*column));
+    }
+
+    size_t CSVColumns::get_row_count() const {
+        return row_count;
+    }
+
+    size_t CSVColumns::get_column_count() const {
+        return columns.size();
+    }
+
+    const CSVColumn& CSVColumns::operator[](size_t schema_index) const {
+        return columns[schema_index];
+    }
+}
@@ -0,0 +1,185 @@
+/*
+ * -----------------------------------------------
+ * CSV Columns
+ * -----------------------------------------------
+ * A CSV table loaded column by column into typed
+ * contiguous vectors: 64-bit integers, doubles,
+ * big integers, or strings encoded as indices in
+ * a dictionary of distinct values. Only columns
+ * listed in the schema are converted.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "bigint.h++"
+#include "csv_document.h++"
+#include <utils/thread_pool.h++>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace PROJECT_NAME {
+    /**
+     * Tells how the cells of a column are converted: INT64 and DOUBLE
+     * parse numbers, BIGINT parses big integers of any length, and STRING
+     * keeps every distinct value once, storing its index for every row.
+     */
+    enum class CSVColumnType {
+        INT64,
+        DOUBLE,
+        BIGINT,
+        STRING
+    };
+
+    struct CSVColumnDefinition {
+        size_t index = 0;
+        CSVColumnType type = CSVColumnType::STRING;
+    };
+
+    struct CSVStringColumn {
+        std::vector<std::string> dictionary;
+        std::vector<uint32_t> codes;
+
+        /**
+         * Returns the value of the row.
+         *
+         * @param row_index The row index
+         * @return The string value
+         */
+        [[nodiscard]]
+        const std::string& operator[](size_t row_index) const {
+            return dictionary[codes[row_index]];
+        }
+    };
+
+    class CSVColumn {
+        CSVColumnDefinition definition;
+        std::variant<std::vector<int64_t>, std::vector<double>, std::vector<bigint>, CSVStringColumn> values;
+
+        void load_integers(const CSVDocument& document);
+
+        void load_doubles(const CSVDocument& document);
+
+        void load_bigints(const CSVDocument& document);
+
+        void load_strings(const CSVDocument& document);
+
+        /**
+         * Returns the cell of this column in the row.
+         *
+         * @throws std::runtime_error When the row has no such cell
+         * @param document The parsed CSV table
+         * @param row_index The row index
+         * @return The cell
+         */
+        [[nodiscard]]
+        std::string_view get_cell(const CSVDocument& document, size_t row_index) const;
+
+        [[noreturn]]
+        void throw_malformed_cell(std::string_view cell, size_t row_index) const;
+    public:
+        /**
+         * Converts a column of the parsed CSV table.
+         *
+         * @throws std::runtime_error When a row has no cell in the column, or a cell cannot be converted to the column type
+         * @param document The parsed CSV table
+         * @param definition The column index in the table and its type
+         */
+        CSVColumn(const CSVDocument& document, CSVColumnDefinition definition);
+
+        /**
+         * Returns the index of this column in the table.
+         * @return The column index
+         */
+        [[nodiscard]]
+        size_t get_index() const;
+
+        /**
+         * Returns the type of this column.
+         * @return The column type
+         */
+        [[nodiscard]]
+        CSVColumnType get_type() const;
+
+        /**
+         * Returns a count of values in this column.
+         * @return The count of rows
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * Returns the values of an INT64 column.
+         * @throws std::logic_error When the column has a different type
+         * @return The values
+         */
+        [[nodiscard]]
+        const std::vector<int64_t>& get_integers() const;
+
+        /**
+         * Returns the values of a DOUBLE column.
+         * @throws std::logic_error When the column has a different type
+         * @return The values
+         */
+        [[nodiscard]]
+        const std::vector<double>& get_doubles() const;
+
+        /**
+         * Returns the values of a BIGINT column.
+         * @throws std::logic_error When the column has a different type
+         * @return The values
+         */
+        [[nodiscard]]
+        const std::vector<bigint>& get_bigints() const;
+
+        /**
+         * Returns the dictionary and the value indices of a STRING column.
+         * @throws std::logic_error When the column has a different type
+         * @return The dictionary-encoded values
+         */
+        [[nodiscard]]
+        const CSVStringColumn& get_strings() const;
+    };
+
+    class CSVColumns {
+        size_t row_count;
+        std::vector<CSVColumn> columns;
+    public:
+        /**
+         * Converts the columns listed in the schema, ignoring the other ones.
+         *
+         * @throws std::runtime_error When a cell is missing or cannot be converted
+         * @param document The parsed CSV table
+         * @param schema The columns to convert, in the order they will be stored
+         * @param thread_pool The thread pool to convert the columns in parallel with, or nullptr to convert them on this thread
+         */
+        CSVColumns(const CSVDocument& document, const std::vector<CSVColumnDefinition>& schema, ThreadPool* thread_pool = nullptr);
+
+        /**
+         * Returns a count of rows in the table.
+         * @return The count of rows
+         */
+        [[nodiscard]]
+        size_t get_row_count() const;
+
+        /**
+         * Returns a count of converted columns.
+         * @return The count of columns in the schema
+         */
+        [[nodiscard]]
+        size_t get_column_count() const;
+
+        /**
+         * Returns a converted column.
+         *
+         * @param schema_index The position of the column in the schema
+         * @return The column
+         */
+        [[nodiscard]]
+        const CSVColumn& operator[](size_t schema_index) const;
+    };
+}
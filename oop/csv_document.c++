@@ -0,0 +1,317 @@
+#include <csv_document.h++>
+#include <csv_scanner.h++>
+#include <cerrno>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std::string_literals;
+
+namespace PROJECT_NAME {
+    CSVDocument::CSVDocument(const std::string& filename, char delimiter, char grouper) : delimiter(delimiter), grouper(grouper) {
+        map(filename);
+
+        try {
+            parse();
+        } catch(...) {
+            unmap();
+            throw;
+        }
+    }
+
+    CSVDocument::CSVDocument(const std::string& filename, ThreadPool& thread_pool, char delimiter, char grouper) : delimiter(delimiter), grouper(grouper) {
+        map(filename);
+
+        try {
+            parse(thread_pool);
+        } catch(...) {
+            unmap();
+            throw;
+        }
+    }
+
+    CSVDocument::CSVDocument(CSVDocument&& other) noexcept
+        : delimiter(other.delimiter), grouper(other.grouper),
+          mapping(std::exchange(other.mapping, nullptr)), mapping_size(std::exchange(other.mapping_size, 0)),
+          cells(std::move(other.cells)), row_offsets(std::exchange(other.row_offsets, { 0 })),
+          chunk_row_offsets(std::exchange(other.chunk_row_offsets, { 0 })), unescaped_cells(std::move(other.unescaped_cells)) {
+        //
+    }
+
+    CSVDocument& CSVDocument::operator=(CSVDocument&& other) noexcept {
+        if(this != &other) {
+            unmap();
+            delimiter = other.delimiter;
+            grouper = other.grouper;
+            mapping = std::exchange(other.mapping, nullptr);
+            mapping_size = std::exchange(other.mapping_size, 0);
+            cells = std::move(other.cells);
+            row_offsets = std::exchange(other.row_offsets, { 0 });
+            chunk_row_offsets = std::exchange(other.chunk_row_offsets, { 0 });
+            unescaped_cells = std::move(other.unescaped_cells);
+        }
+
+        return *this;
+    }
+
+    CSVDocument::~CSVDocument() {
+        unmap();
+    }
+
+    void CSVDocument::map(const std::string& filename) {
+        if(delimiter == grouper)
+            throw std::invalid_argument("CSV parser should have different delimiter and group, but all of them is set to character: '"s + delimiter + "'");
+
+        int file_descriptor = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if(file_descriptor == -1)
+            throw std::runtime_error("Cannot open file '"s + filename + "' for reading CSV table: " + std::strerror(errno));
+
+        struct stat file_status {};
+        if(::fstat(file_descriptor, &file_status) == -1) {
+            ::close(file_descriptor);
+            throw std::runtime_error("Cannot get the size of file '"s + filename + "': " + std::strerror(errno));
+        }
+
+        mapping_size = file_status.st_size;
+
+        if(mapping_size != 0) {
+            void* file_mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if(file_mapping == MAP_FAILED) {
+                ::close(file_descriptor);
+                mapping_size = 0;
+                throw std::runtime_error("Cannot map file '"s + filename + "' for reading CSV table: " + std::strerror(errno));
+            }
+
+            ::madvise(file_mapping, mapping_size, MADV_SEQUENTIAL);
+            mapping = static_cast<const char*>(file_mapping);
+        }
+
+        ::close(file_descriptor);
+    }
+
+    void CSVDocument::unmap() {
+        if(mapping != nullptr)
+            ::munmap(const_cast<char*>(mapping), mapping_size);
+
+        mapping = nullptr;
+        mapping_size = 0;
+    }
+
+    std::string_view CSVDocument::unescape_cell(Part& part, std::string_view raw_cell) const {
+        if(raw_cell.find(grouper) == std::string_view::npos)
+            return raw_cell;
+
+        if(raw_cell.size() >= 2 && raw_cell.front() == grouper && raw_cell.back() == grouper && raw_cell.substr(1, raw_cell.size() - 2).find(grouper) == std::string_view::npos)
+            return raw_cell.substr(1, raw_cell.size() - 2);
+
+        std::string& cell = part.unescaped_cells.emplace_back();
+        CSVScanner::unescape(raw_cell, grouper, cell);
+        return cell;
+    }
+
+    void CSVDocument::end_cell(Part& part, size_t cell_end) const {
+        bool row_is_over = cell_end == mapping_size || mapping[cell_end] == '\n';
+
+        if(row_is_over && cell_end == part.row_start) {
+            part.row_start = part.cell_start = cell_end + 1;
+            return;
+        }
+
+        std::string_view raw_cell { mapping + part.cell_start, cell_end - part.cell_start };
+        if(!row_is_over || !raw_cell.empty())
+            part.cells.push_back(unescape_cell(part, raw_cell));
+
+        part.cell_start = cell_end + 1;
+        if(row_is_over) {
+            part.row_offsets.push_back(part.cells.size());
+            part.row_start = part.cell_start;
+        }
+    }
+
+    void CSVDocument::parse() {
+        CSVScanner scanner { delimiter, grouper };
+        std::vector<size_t> separators;
+        std::vector<Part> parts(1);
+
+        for(size_t chunk_start = 0; chunk_start < mapping_size; chunk_start += SCANNING_CHUNK_SIZE) {
+            separators.clear();
+            scanner.scan({ mapping + chunk_start, std::min(SCANNING_CHUNK_SIZE, mapping_size - chunk_start) }, chunk_start, separators);
+
+            for(auto separator : separators)
+                end_cell(parts.front(), separator);
+        }
+
+        if(scanner.is_in_group())
+            throw std::runtime_error("CSV table ends inside a group. Please, add character '"s + grouper + "' to close it.");
+
+        if(parts.front().row_start < mapping_size)
+            end_cell(parts.front(), mapping_size);
+
+        assemble(parts, nullptr);
+    }
+
+    void CSVDocument::parse(ThreadPool& thread_pool) {
+        auto chunk_count = std::clamp<size_t>(mapping_size / SCANNING_CHUNK_SIZE, 1, thread_pool.get_thread_count() * CHUNKS_PER_THREAD);
+        if(chunk_count == 1)
+            return parse();
+
+        auto chunk_size = (mapping_size + chunk_count - 1) / chunk_count;
+        chunk_count = (mapping_size + chunk_size - 1) / chunk_size;
+
+        std::vector<std::vector<size_t>> separators(chunk_count);
+        std::vector<char> chunk_ends_in_group(chunk_count);
+
+        auto scan_chunk = [&](size_t chunk_index, bool starts_in_group) {
+            auto chunk_start = chunk_index * chunk_size;
+            CSVScanner scanner { delimiter, grouper, CSVScanner::get_best_implementation(), starts_in_group };
+
+            separators[chunk_index].clear();
+            scanner.scan({ mapping + chunk_start, std::min(chunk_size, mapping_size - chunk_start) }, chunk_start, separators[chunk_index]);
+            chunk_ends_in_group[chunk_index] = scanner.is_in_group();
+        };
+
+        thread_pool.parallel_for(chunk_count, [&](size_t chunk_index) {
+            scan_chunk(chunk_index, false);
+        });
+
+        std::vector<size_t> mispredicted_chunks;
+        bool in_group = false;
+
+        for(size_t chunk_index = 0; chunk_index < chunk_count; chunk_index++) {
+            if(in_group)
+                mispredicted_chunks.push_back(chunk_index);
+
+            in_group = in_group != static_cast<bool>(chunk_ends_in_group[chunk_index]);
+        }
+
+        if(in_group)
+            throw std::runtime_error("CSV table ends inside a group. Please, add character '"s + grouper + "' to close it.");
+
+        thread_pool.parallel_for(mispredicted_chunks.size(), [&](size_t index) {
+            scan_chunk(mispredicted_chunks[index], true);
+        });
+
+        std::vector<Part> parts(chunk_count);
+
+        thread_pool.parallel_for(chunk_count, [&](size_t chunk_index) {
+            Part& part = parts[chunk_index];
+            const auto& chunk_separators = separators[chunk_index];
+            auto separator = chunk_separators.begin();
+
+            if(chunk_index != 0) {
+                separator = std::find_if(chunk_separators.begin(), chunk_separators.end(), [&](size_t position) { return mapping[position] == '\n'; });
+                if(separator == chunk_separators.end())
+                    return;
+
+                part.row_start = part.cell_start = *separator + 1;
+                ++separator;
+            }
+
+            for(; separator != chunk_separators.end(); ++separator)
+                end_cell(part, *separator);
+
+            for(auto next_chunk_index = chunk_index + 1; next_chunk_index < chunk_count; next_chunk_index++) {
+                for(auto next_separator : separators[next_chunk_index]) {
+                    end_cell(part, next_separator);
+
+                    if(mapping[next_separator] == '\n')
+                        return;
+                }
+            }
+
+            if(part.row_start < mapping_size)
+                end_cell(part, mapping_size);
+        });
+
+        assemble(parts, &thread_pool);
+    }
+
+    void CSVDocument::assemble(std::vector<Part>& parts, ThreadPool* thread_pool) {
+        std::vector<size_t> part_cell_offsets = { 0 };
+        chunk_row_offsets = { 0 };
+
+        for(const auto& part : parts) {
+            part_cell_offsets.push_back(part_cell_offsets.back() + part.cells.size());
+            chunk_row_offsets.push_back(chunk_row_offsets.back() + part.row_offsets.size() - 1);
+        }
+
+        if(parts.size() == 1) {
+            cells = std::move(parts.front().cells);
+            row_offsets = std::move(parts.front().row_offsets);
+        } else {
+            cells.resize(part_cell_offsets.back());
+            row_offsets.resize(chunk_row_offsets.back() + 1);
+
+            auto copy_part = [&](size_t part_index) {
+                const auto& part = parts[part_index];
+                std::copy(part.cells.begin(), part.cells.end(), cells.begin() + static_cast<std::ptrdiff_t>(part_cell_offsets[part_index]));
+
+                for(size_t row_index = 1; row_index < part.row_offsets.size(); row_index++)
+                    row_offsets[chunk_row_offsets[part_index] + row_index] = part_cell_offsets[part_index] + part.row_offsets[row_index];
+            };
+
+            if(thread_pool != nullptr) {
+                thread_pool->parallel_for(parts.size(), copy_part);
+            } else {
+                for(size_t part_index = 0; part_index < parts.size(); part_index++)
+                    copy_part(part_index);
+            }
+        }
+
+        for(auto& part : parts)
+            if(!part.unescaped_cells.empty())
+                unescaped_cells.push_back(std::move(part.unescaped_cells));
+    }
+
+    size_t CSVDocument::size() const {
+        return row_offsets.size() - 1;
+    }
+
+    CSVDocument::Row CSVDocument::operator[](size_t row_index) const {
+        return Row(cells).subspan(row_offsets[row_index], row_offsets[row_index + 1] - row_offsets[row_index]);
+    }
+
+    CSVDocument::Row CSVDocument::at(size_t row_index) const {
+        if(row_index >= size())
+            throw std::out_of_range("CSV document has "s + std::to_string(size()) + " rows, so there is no row #" + std::to_string(row_index));
+
+        return (*this)[row_index];
+    }
+
+    size_t CSVDocument::get_chunk_count() const {
+        return chunk_row_offsets.size() - 1;
+    }
+
+    size_t CSVDocument::get_chunk_first_row(size_t chunk_index) const {
+        return chunk_row_offsets.at(chunk_index);
+    }
+
+    size_t CSVDocument::get_unescaped_cell_count() const {
+        size_t unescaped_cell_count = 0;
+        for(const auto& part_unescaped_cells : unescaped_cells)
+            unescaped_cell_count += part_unescaped_cells.size();
+
+        return unescaped_cell_count;
+    }
+
+    std::vector<std::vector<std::string>> CSVDocument::to_table() const {
+        return to_table(0, size());
+    }
+
+    std::vector<std::vector<std::string>> CSVDocument::to_table(size_t first_row, size_t last_row) const {
+        std::vector<std::vector<std::string>> csv_table;
+        csv_table.reserve(last_row - first_row);
+
+        for(size_t row_index = first_row; row_index < last_row; row_index++) {
+            auto row = (*this)[row_index];
+            csv_table.emplace_back(row.begin(), row.end());
+        }
+
+        return csv_table;
+    }
+}
@@ -0,0 +1,194 @@
+/*
+ * -----------------------------------------------
+ * CSV Document
+ * -----------------------------------------------
+ * A CSV table parsed straight from a memory-mapped
+ * file. Cells are string views into the mapping,
+ * only cells that need unescaping are copied, so
+ * parsing barely allocates. The views are valid as
+ * long as the document is alive. Large files can
+ * be parsed in chunks on a thread pool.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <utils/thread_pool.h++>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PROJECT_NAME {
+    class CSVDocument {
+        static constexpr size_t SCANNING_CHUNK_SIZE = 1 << 20;
+        static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+        /**
+         * Rows parsed from a range of the table. The rows of a part start after
+         * the first newline of its chunk and end at the first newline after it.
+         */
+        struct Part {
+            std::vector<std::string_view> cells;
+            std::vector<size_t> row_offsets = { 0 };
+            std::deque<std::string> unescaped_cells;
+            size_t row_start = 0, cell_start = 0;
+        };
+
+        char delimiter, grouper;
+        const char* mapping = nullptr;
+        size_t mapping_size = 0;
+        std::vector<std::string_view> cells;
+        std::vector<size_t> row_offsets = { 0 }, chunk_row_offsets = { 0 };
+        std::vector<std::deque<std::string>> unescaped_cells;
+
+        void map(const std::string& filename);
+
+        void unmap();
+
+        /**
+         * Splits the mapped table into rows and cells, finding the cell separators with a CSVScanner.
+         * @throws std::runtime_error When the table ends inside a group
+         */
+        void parse();
+
+        /**
+         * Splits the mapped table into chunks, scans them in parallel speculating that
+         * no chunk starts inside a group, rescans the mispredicted ones, and parses
+         * the rows starting in every chunk in parallel.
+         *
+         * @throws std::runtime_error When the table ends inside a group
+         * @param thread_pool The thread pool
+         */
+        void parse(ThreadPool& thread_pool);
+
+        /**
+         * Adds a cell ending at the position to the part, ending the row if the cell is the last one.
+         *
+         * @param part The part being parsed
+         * @param cell_end The position of the separator after the cell, or the table size
+         */
+        void end_cell(Part& part, size_t cell_end) const;
+
+        /**
+         * Returns the cell value, copying it to the part only if the groupers
+         * in it are not just a pair around the whole cell.
+         *
+         * @param part The part being parsed
+         * @param raw_cell The cell as it is written in the table
+         * @return The cell value
+         */
+        std::string_view unescape_cell(Part& part, std::string_view raw_cell) const;
+
+        /**
+         * Concatenates the parts to the document in order.
+         *
+         * @param parts The parsed parts
+         * @param thread_pool The thread pool to copy the cells with, or nullptr to copy them on this thread
+         */
+        void assemble(std::vector<Part>& parts, ThreadPool* thread_pool);
+    public:
+        using Row = std::span<const std::string_view>;
+
+        /**
+         * Maps the file and parses the CSV table stored in it. Rows are split
+         * as CSVRowStream splits them.
+         *
+         * @see CSVRowStream::next()
+         * @throws std::runtime_error When the file cannot be mapped or the table ends inside a group
+         * @param filename The CSV table file
+         * @param delimiter The CSV cell delimiter
+         * @param grouper The CSV cell grouper
+         */
+        explicit CSVDocument(const std::string& filename, char delimiter = ',', char grouper = '"');
+
+        /**
+         * Maps the file and parses the CSV table stored in it in chunks on the thread pool.
+         * The result is the same as if it was parsed on a single thread.
+         *
+         * @throws std::runtime_error When the file cannot be mapped or the table ends inside a group
+         * @param filename The CSV table file
+         * @param thread_pool The thread pool
+         * @param delimiter The CSV cell delimiter
+         * @param grouper The CSV cell grouper
+         */
+        CSVDocument(const std::string& filename, ThreadPool& thread_pool, char delimiter = ',', char grouper = '"');
+
+        CSVDocument(CSVDocument&& other) noexcept;
+        CSVDocument& operator=(CSVDocument&& other) noexcept;
+        CSVDocument(const CSVDocument&) = delete;
+        CSVDocument& operator=(const CSVDocument&) = delete;
+
+        ~CSVDocument();
+
+        /**
+         * Returns a count of rows in the table.
+         * @return The count of rows
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * Returns the cells of a row.
+         *
+         * @param row_index The row index, should be less than size()
+         * @return The row cells
+         */
+        [[nodiscard]]
+        Row operator[](size_t row_index) const;
+
+        /**
+         * Returns the cells of a row.
+         *
+         * @throws std::out_of_range When there is no row with the index
+         * @param row_index The row index
+         * @return The row cells
+         */
+        [[nodiscard]]
+        Row at(size_t row_index) const;
+
+        /**
+         * Returns a count of chunks the table was parsed in, which is 1 unless it was parsed on a thread pool.
+         * @return The count of chunks
+         */
+        [[nodiscard]]
+        size_t get_chunk_count() const;
+
+        /**
+         * Returns the index of the first row starting in the chunk. The rows of a chunk
+         * end where the rows of the next one begin, the last chunk ends at size().
+         *
+         * @param chunk_index The chunk index, which may be equal to the count of chunks
+         * @return The row index
+         */
+        [[nodiscard]]
+        size_t get_chunk_first_row(size_t chunk_index) const;
+
+        /**
+         * Returns a count of cells that were copied to be unescaped.
+         * @return The count of copied cells
+         */
+        [[nodiscard]]
+        size_t get_unescaped_cell_count() const;
+
+        /**
+         * Copies the table to STL containers, as CSV::parse_file() returns it.
+         * @return The CSV table stored in 2D-vector
+         */
+        [[nodiscard]]
+        std::vector<std::vector<std::string>> to_table() const;
+
+        /**
+         * Copies the rows to STL containers.
+         *
+         * @param first_row The index of the first row to copy
+         * @param last_row The index after the last row to copy
+         * @return The rows stored in 2D-vector
+         */
+        [[nodiscard]]
+        std::vector<std::vector<std::string>> to_table(size_t first_row, size_t last_row) const;
+    };
+}
@@ -0,0 +1,199 @@
+#include <csv_scanner.h++>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define OOP_CSV_SCANNER_X86
+#include <immintrin.h>
+#endif
+
+using namespace std::string_literals;
+
+namespace PROJECT_NAME {
+    namespace {
+        struct BlockMasks {
+            uint64_t groupers, separators;
+        };
+
+        using FindMasksFunction = BlockMasks (*)(const char* block, char delimiter, char grouper);
+        using PrefixXorFunction = uint64_t (*)(uint64_t mask);
+
+        BlockMasks find_masks_scalar(const char* block, char delimiter, char grouper) {
+            BlockMasks masks { 0, 0 };
+
+            for(size_t index = 0; index < CSVScanner::BLOCK_SIZE; index++) {
+                masks.groupers |= static_cast<uint64_t>(block[index] == grouper) << index;
+                masks.separators |= static_cast<uint64_t>(block[index] == delimiter || block[index] == '\n') << index;
+            }
+
+            return masks;
+        }
+
+        /**
+         * Sets every bit to the parity of the set bits up to it, inclusively,
+         * so the bits between an opening and a closing grouper are set.
+         */
+        uint64_t prefix_xor_by_shifts(uint64_t mask) {
+            mask ^= mask << 1;
+            mask ^= mask << 2;
+            mask ^= mask << 4;
+            mask ^= mask << 8;
+            mask ^= mask << 16;
+            mask ^= mask << 32;
+            return mask;
+        }
+
+#ifdef OOP_CSV_SCANNER_X86
+        __attribute__((target("sse4.2")))
+        BlockMasks find_masks_sse42(const char* block, char delimiter, char grouper) {
+            auto delimiters = _mm_set1_epi8(delimiter), groupers = _mm_set1_epi8(grouper), newlines = _mm_set1_epi8('\n');
+            BlockMasks masks { 0, 0 };
+
+            for(size_t index = 0; index < CSVScanner::BLOCK_SIZE; index += 16) {
+                auto characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + index));
+                auto separators = _mm_or_si128(_mm_cmpeq_epi8(characters, delimiters), _mm_cmpeq_epi8(characters, newlines));
+                masks.groupers |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(characters, groupers)))) << index;
+                masks.separators |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(separators))) << index;
+            }
+
+            return masks;
+        }
+
+        __attribute__((target("avx2")))
+        BlockMasks find_masks_avx2(const char* block, char delimiter, char grouper) {
+            auto delimiters = _mm256_set1_epi8(delimiter), groupers = _mm256_set1_epi8(grouper), newlines = _mm256_set1_epi8('\n');
+            BlockMasks masks { 0, 0 };
+
+            for(size_t index = 0; index < CSVScanner::BLOCK_SIZE; index += 32) {
+                auto characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + index));
+                auto separators = _mm256_or_si256(_mm256_cmpeq_epi8(characters, delimiters), _mm256_cmpeq_epi8(characters, newlines));
+                masks.groupers |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(characters, groupers)))) << index;
+                masks.separators |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(separators))) << index;
+            }
+
+            return masks;
+        }
+
+        /**
+         * Does the same as prefix_xor_by_shifts() with a single carry-less multiplication by all ones.
+         */
+        __attribute__((target("pclmul")))
+        uint64_t prefix_xor_by_multiplication(uint64_t mask) {
+            auto product = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<long long>(mask)), _mm_set1_epi8(static_cast<char>(0xFF)), 0);
+            return static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+        }
+#endif
+
+        /**
+         * Scans the data block by block, copying the last incomplete block to a padded one.
+         * Returns the group mask of the last byte, all ones if it is inside a group.
+         */
+        template<FindMasksFunction find_masks, PrefixXorFunction prefix_xor>
+        uint64_t scan_blocks(const char* data, size_t size, size_t offset, char delimiter, char grouper, uint64_t group_mask, std::vector<size_t>& separators) {
+            for(size_t position = 0; position < size; position += CSVScanner::BLOCK_SIZE) {
+                BlockMasks masks;
+
+                if(size - position >= CSVScanner::BLOCK_SIZE) {
+                    masks = find_masks(data + position, delimiter, grouper);
+                } else {
+                    char padded_block[CSVScanner::BLOCK_SIZE] {};
+                    std::memcpy(padded_block, data + position, size - position);
+                    masks = find_masks(padded_block, delimiter, grouper);
+
+                    auto tail_mask = (uint64_t { 1 } << (size - position)) - 1;
+                    masks.groupers &= tail_mask;
+                    masks.separators &= tail_mask;
+                }
+
+                auto groups = prefix_xor(masks.groupers) ^ group_mask;
+                group_mask = static_cast<uint64_t>(static_cast<int64_t>(groups) >> 63);
+
+                for(auto separators_mask = masks.separators & ~groups; separators_mask != 0; separators_mask &= separators_mask - 1)
+                    separators.push_back(offset + position + std::countr_zero(separators_mask));
+            }
+
+            return group_mask;
+        }
+
+        CSVScanner::ScanFunction get_scan_function(CSVScannerImplementation implementation) {
+            switch(implementation) {
+#ifdef OOP_CSV_SCANNER_X86
+                case CSVScannerImplementation::AVX2:
+                    return scan_blocks<find_masks_avx2, prefix_xor_by_multiplication>;
+                case CSVScannerImplementation::SSE42:
+                    if(__builtin_cpu_supports("pclmul"))
+                        return scan_blocks<find_masks_sse42, prefix_xor_by_multiplication>;
+
+                    return scan_blocks<find_masks_sse42, prefix_xor_by_shifts>;
+#endif
+                default:
+                    return scan_blocks<find_masks_scalar, prefix_xor_by_shifts>;
+            }
+        }
+    }
+
+    CSVScanner::CSVScanner(char delimiter, char grouper, CSVScannerImplementation implementation, bool in_group)
+        : delimiter(delimiter), grouper(grouper), implementation(implementation), scan_function(get_scan_function(implementation)), group_mask(in_group ? ~uint64_t { 0 } : 0) {
+        if(delimiter == grouper)
+            throw std::invalid_argument("CSV scanner should have different delimiter and group, but all of them is set to character: '"s + delimiter + "'");
+
+        if(!is_supported(implementation))
+            throw std::invalid_argument("CSV scanner implementation #"s + std::to_string(static_cast<int>(implementation)) + " is not supported by this processor");
+    }
+
+    void CSVScanner::scan(std::string_view chunk, size_t offset, std::vector<size_t>& separators) {
+        group_mask = scan_function(chunk.data(), chunk.size(), offset, delimiter, grouper, group_mask, separators);
+    }
+
+    void CSVScanner::unescape(std::string_view raw_cell, char grouper, std::string& cell) {
+        bool in_group = false;
+
+        for(size_t position = 0; position < raw_cell.size(); position++) {
+            if(raw_cell[position] != grouper) {
+                cell += raw_cell[position];
+            } else if(in_group && position + 1 < raw_cell.size() && raw_cell[position + 1] == grouper) {
+                cell += grouper;
+                position++;
+            } else {
+                in_group = !in_group;
+            }
+        }
+    }
+
+    bool CSVScanner::is_in_group() const {
+        return group_mask != 0;
+    }
+
+    CSVScannerImplementation CSVScanner::get_implementation() const {
+        return implementation;
+    }
+
+    bool CSVScanner::is_supported(CSVScannerImplementation implementation) {
+        switch(implementation) {
+#ifdef OOP_CSV_SCANNER_X86
+            case CSVScannerImplementation::AVX2:
+                return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("pclmul");
+            case CSVScannerImplementation::SSE42:
+                return __builtin_cpu_supports("sse4.2");
+#endif
+            case CSVScannerImplementation::SCALAR:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    CSVScannerImplementation CSVScanner::get_best_implementation() {
+        static const auto best_implementation = [] {
+            for(auto implementation : { CSVScannerImplementation::AVX2, CSVScannerImplementation::SSE42 })
+                if(is_supported(implementation))
+                    return implementation;
+
+            return CSVScannerImplementation::SCALAR;
+        }();
+
+        return best_implementation;
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * -----------------------------------------------
+ * CSV Scanner
+ * -----------------------------------------------
+ * Finds the cell separators of a CSV table, that
+ * is delimiters and newlines outside of groups,
+ * 64 bytes at a time. Characters are compared with
+ * vector instructions, and the groups are masked
+ * with a carry-less multiplication, as simdjson
+ * does it. The instruction set is chosen at runtime.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PROJECT_NAME {
+    /**
+     * Tells which instructions a CSV scanner uses: AVX2 compares
+     * 32 bytes at once, SSE42 compares 16 bytes at once, and SCALAR
+     * compares byte by byte and runs on any processor.
+     */
+    enum class CSVScannerImplementation {
+        SCALAR,
+        SSE42,
+        AVX2
+    };
+
+    class CSVScanner {
+    public:
+        static constexpr size_t BLOCK_SIZE = 64;
+
+        using ScanFunction = uint64_t (*)(const char* data, size_t size, size_t offset, char delimiter, char grouper, uint64_t group_mask, std::vector<size_t>& separators);
+    private:
+        char delimiter, grouper;
+        CSVScannerImplementation implementation;
+        ScanFunction scan_function;
+        uint64_t group_mask;
+    public:
+        /**
+         * Creates a new CSV scanner.
+         *
+         * @throws std::invalid_argument When the delimiter and the grouper are the same, or the implementation is not supported
+         * @param delimiter The CSV cell delimiter
+         * @param grouper The CSV cell grouper
+         * @param implementation The instructions to use, the best supported ones by default
+         * @param in_group Whether the first chunk starts inside a group
+         */
+        explicit CSVScanner(char delimiter = ',', char grouper = '"', CSVScannerImplementation implementation = get_best_implementation(), bool in_group = false);
+
+        /**
+         * Appends the positions of the cell separators in the chunk. Chunks should be
+         * scanned in the order they follow in the table, a group may continue to the next chunk.
+         *
+         * @param chunk The next chunk of the CSV table
+         * @param offset The position of the chunk in the table, which is added to the separator positions
+         * @param separators The vector the separator positions are appended to
+         */
+        void scan(std::string_view chunk, size_t offset, std::vector<size_t>& separators);
+
+        /**
+         * Appends the value of a cell found between two separators to the string:
+         * the groupers are removed, and two groupers in a row inside a group stand
+         * for a single grouper character.
+         *
+         * @param raw_cell The cell as it is written in the table
+         * @param grouper The CSV cell grouper
+         * @param cell The string the value is appended to
+         */
+        static void unescape(std::string_view raw_cell, char grouper, std::string& cell);
+
+        /**
+         * Tells whether the last scanned chunk ends inside a group.
+         * @return True if a group is not closed yet
+         */
+        [[nodiscard]]
+        bool is_in_group() const;
+
+        /**
+         * Returns the instructions this scanner uses.
+         * @return The scanner implementation
+         */
+        [[nodiscard]]
+        CSVScannerImplementation get_implementation() const;
+
+        /**
+         * Tells whether the processor supports the implementation.
+         *
+         * @param implementation The scanner implementation
+         * @return True if the implementation can be used
+         */
+        [[nodiscard]]
+        static bool is_supported(CSVScannerImplementation implementation);
+
+        /**
+         * Returns the fastest implementation the processor supports.
+         * @return The scanner implementation
+         */
+        [[nodiscard]]
+        static CSVScannerImplementation get_best_implementation();
+    };
+}
@@ -0,0 +1,176 @@
+#include <csv_writer.h++>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std::string_literals;
+
+namespace PROJECT_NAME {
+    CSVWriter::CSVWriter(std::string filename, CSVWriteMode mode, char delimiter, char grouper, size_t buffer_size)
+        : filename(std::move(filename)), mode(mode), delimiter(delimiter), grouper(grouper), buffer_size(buffer_size) {
+        if(delimiter == grouper)
+            throw std::invalid_argument("CSV writer should have different delimiter and group, but all of them is set to character: '"s + delimiter + "'");
+
+        int flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+        output_filename = this->filename;
+
+        switch(mode) {
+            case CSVWriteMode::REPLACE:
+                flags |= O_TRUNC;
+                break;
+            case CSVWriteMode::APPEND:
+                flags |= O_APPEND;
+                break;
+            case CSVWriteMode::ATOMIC_REPLACE:
+                flags |= O_TRUNC;
+                output_filename += ".tmp-" + std::to_string(::getpid());
+                break;
+        }
+
+        file_descriptor = ::open(output_filename.c_str(), flags, 0644);
+        if(file_descriptor == -1)
+            throw std::runtime_error("Cannot open file '"s + output_filename + "' for writing CSV table: " + std::strerror(errno));
+
+        buffer.reserve(buffer_size);
+    }
+
+    CSVWriter::CSVWriter(CSVWriter&& other) noexcept
+        : filename(std::move(other.filename)), output_filename(std::move(other.output_filename)), mode(other.mode),
+          delimiter(other.delimiter), grouper(other.grouper), buffer_size(other.buffer_size),
+          buffer(std::move(other.buffer)), file_descriptor(std::exchange(other.file_descriptor, -1)) {
+        //
+    }
+
+    CSVWriter::~CSVWriter() {
+        if(file_descriptor == -1)
+            return;
+
+        if(mode == CSVWriteMode::ATOMIC_REPLACE) {
+            close_file();
+            ::unlink(output_filename.c_str());
+            return;
+        }
+
+        try {
+            write_buffer();
+        } catch(const std::runtime_error&) {
+            //
+        }
+
+        close_file();
+    }
+
+    void CSVWriter::append_cell(std::string_view cell, bool first) {
+        if(!first)
+            buffer += delimiter;
+
+        row_ends_with_empty_cell = cell.empty();
+
+        const char special_characters[] = { delimiter, grouper, '\n', '\r' };
+        if(cell.find_first_of(std::string_view(special_characters, sizeof(special_characters))) == std::string_view::npos) {
+            buffer.append(cell);
+            return;
+        }
+
+        buffer += grouper;
+        for(size_t grouper_position = cell.find(grouper); grouper_position != std::string_view::npos; grouper_position = cell.find(grouper)) {
+            buffer.append(cell.substr(0, grouper_position + 1));
+            buffer += grouper;
+            cell.remove_prefix(grouper_position + 1);
+        }
+
+        buffer.append(cell);
+        buffer += grouper;
+    }
+
+    void CSVWriter::end_row() {
+        if(row_ends_with_empty_cell) {
+            buffer += grouper;
+            buffer += grouper;
+            row_ends_with_empty_cell = false;
+        }
+
+        buffer += '\n';
+
+        if(buffer.size() >= buffer_size)
+            write_buffer();
+    }
+
+    void CSVWriter::write_row(std::initializer_list<std::string_view> row) {
+        write_row<std::initializer_list<std::string_view>>(row);
+    }
+
+    void CSVWriter::write_buffer() {
+        std::string_view remaining_buffer = buffer;
+
+        while(!remaining_buffer.empty()) {
+            ssize_t written_size = ::write(file_descriptor, remaining_buffer.data(), remaining_buffer.size());
+
+            if(written_size == -1) {
+                if(errno == EINTR)
+                    continue;
+
+                throw std::runtime_error("CSV table file '"s + output_filename + "' cannot be written: " + std::strerror(errno));
+            }
+
+            remaining_buffer.remove_prefix(written_size);
+        }
+
+        buffer.clear();
+    }
+
+    void CSVWriter::close_file() {
+        ::close(file_descriptor);
+        file_descriptor = -1;
+    }
+
+    void CSVWriter::flush() {
+        if(file_descriptor == -1)
+            throw std::logic_error("CSV writer of file '"s + filename + "' is already closed");
+
+        write_buffer();
+    }
+
+    void CSVWriter::sync() {
+        flush();
+
+        if(::fsync(file_descriptor) == -1)
+            throw std::runtime_error("CSV table file '"s + output_filename + "' cannot be synchronized: " + std::strerror(errno));
+    }
+
+    void CSVWriter::close() {
+        flush();
+
+        if(mode == CSVWriteMode::ATOMIC_REPLACE) {
+            if(::fsync(file_descriptor) == -1) {
+                auto error = errno;
+                close_file();
+                ::unlink(output_filename.c_str());
+                throw std::runtime_error("CSV table file '"s + output_filename + "' cannot be synchronized: " + std::strerror(error));
+            }
+
+            close_file();
+
+            if(::rename(output_filename.c_str(), filename.c_str()) == -1) {
+                auto error = errno;
+                ::unlink(output_filename.c_str());
+                throw std::runtime_error("CSV table file '"s + output_filename + "' cannot be renamed to '" + filename + "': " + std::strerror(error));
+            }
+
+            auto directory = std::filesystem::path(filename).parent_path();
+            int directory_descriptor = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if(directory_descriptor != -1) {
+                ::fsync(directory_descriptor);
+                ::close(directory_descriptor);
+            }
+
+            return;
+        }
+
+        close_file();
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * -----------------------------------------------
+ * CSV Writer
+ * -----------------------------------------------
+ * Writes CSV tables row by row through a large
+ * buffer. Cells are grouped only when they need
+ * it, and groupers inside them are doubled, as
+ * RFC 4180 tells. A file can be replaced, appended
+ * to, or replaced atomically through a temporary one.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+namespace PROJECT_NAME {
+    /**
+     * Tells how a CSV writer opens the file: REPLACE truncates it,
+     * APPEND writes after the existing rows, and ATOMIC_REPLACE writes
+     * to a temporary file that replaces the file only when the writer is closed.
+     */
+    enum class CSVWriteMode {
+        REPLACE,
+        APPEND,
+        ATOMIC_REPLACE
+    };
+
+    class CSVWriter {
+        std::string filename, output_filename;
+        CSVWriteMode mode;
+        char delimiter, grouper;
+        size_t buffer_size;
+        std::string buffer;
+        int file_descriptor = -1;
+        bool row_ends_with_empty_cell = false;
+
+        /**
+         * Appends a cell to the buffer, grouping it if it contains
+         * a delimiter, a grouper or a line break. An empty last cell
+         * is grouped by end_row(), otherwise it would be lost.
+         *
+         * @param cell The cell
+         * @param first Whether the cell is the first one in its row
+         */
+        void append_cell(std::string_view cell, bool first);
+
+        void end_row();
+
+        void write_buffer();
+
+        void close_file();
+    public:
+        /**
+         * Opens a file for writing a CSV table, creating it if it does not exist.
+         *
+         * @throws std::runtime_error When the file cannot be opened
+         * @throws std::invalid_argument When the delimiter and the grouper are the same
+         * @param filename The CSV table file
+         * @param mode How the file is written
+         * @param delimiter The CSV cell delimiter
+         * @param grouper The CSV cell grouper
+         * @param buffer_size A size of the buffer rows are collected in before writing
+         */
+        explicit CSVWriter(std::string filename, CSVWriteMode mode = CSVWriteMode::REPLACE, char delimiter = ',', char grouper = '"', size_t buffer_size = 1 << 20);
+
+        CSVWriter(CSVWriter&& other) noexcept;
+        CSVWriter& operator=(CSVWriter&&) = delete;
+        CSVWriter(const CSVWriter&) = delete;
+        CSVWriter& operator=(const CSVWriter&) = delete;
+
+        /**
+         * Writes the buffer and closes the file, ignoring errors. An atomic writer
+         * that was not closed removes its temporary file, leaving the file untouched.
+         */
+        ~CSVWriter();
+
+        /**
+         * Appends a row to the buffer, writing the buffer when it is full.
+         *
+         * @param row The row cells, anything convertible to a string view
+         */
+        template<typename Row>
+        void write_row(const Row& row) {
+            bool first = true;
+            for(const auto& cell : row) {
+                append_cell(cell, first);
+                first = false;
+            }
+
+            end_row();
+        }
+
+        /**
+         * Appends a row to the buffer, writing the buffer when it is full.
+         * @param row The row cells
+         */
+        void write_row(std::initializer_list<std::string_view> row);
+
+        /**
+         * Appends the rows to the buffer, writing the buffer when it is full.
+         * @param rows The rows, e.g. a CSV table stored in 2D-vector
+         */
+        template<typename Rows>
+        void write_rows(const Rows& rows) {
+            for(const auto& row : rows)
+                write_row(row);
+        }
+
+        /**
+         * Writes the buffer to the file.
+         * @throws std::runtime_error When the file cannot be written
+         */
+        void flush();
+
+        /**
+         * Writes the buffer to the file and waits until the file is synchronized to the disk.
+         * @throws std::runtime_error When the file cannot be written or synchronized
+         */
+        void sync();
+
+        /**
+         * Writes the buffer and closes the file. An atomic writer synchronizes
+         * the temporary file to the disk and renames it to the file.
+         *
+         * @throws std::runtime_error When the file cannot be written or renamed
+         */
+        void close();
+    };
+}
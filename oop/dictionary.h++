@@ -3,6 +3,16 @@
  * Dictionary
  * -----------------------------------------------
  * Is a key-value container with unique keys.
+ * Pairs are stored densely in insertion order and
+ * indexed by an open-addressing Robin Hood hash
+ * table, so lookups take constant time.
+ *
+ * Putting a value for an existing key replaces
+ * it in place, so the key keeps its position
+ * instead of moving to the end. get_keys() and
+ * get_values() return views over the pairs, not
+ * copies: build a std::vector from them if the
+ * dictionary changes while they are used.
  *
  * @since OOP 1.0.0.0
  * @author Anatoly Frolov - contact@anafro.ru
@@ -10,105 +20,268 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace PROJECT_NAME {
-    template<typename K, typename V>
+    template<typename T>
+    struct DictionaryHash : std::hash<T> {
+        //
+    };
+
+    template<>
+    struct DictionaryHash<std::string> {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view key) const noexcept {
+            return std::hash<std::string_view> {}(key);
+        }
+    };
+
+    template<typename K, typename V, typename Hash = DictionaryHash<K>>
     class Dictionary {
         using Key = K;
         using Value = V;
 
+        static constexpr size_t EMPTY_SLOT = std::numeric_limits<size_t>::max();
+        static constexpr size_t MIN_SLOT_COUNT_BITS = 3;
+
+        struct Slot {
+            size_t pair_index = EMPTY_SLOT;
+            uint64_t hash = 0;
+        };
+
         std::vector<std::pair<Key, Value>> pairs;
+        std::vector<Slot> slots = std::vector<Slot>(size_t { 1 } << MIN_SLOT_COUNT_BITS);
+        unsigned int slot_count_bits = MIN_SLOT_COUNT_BITS;
+
+        [[nodiscard]]
+        size_t get_home_slot(uint64_t hash) const {
+            return static_cast<size_t>(hash >> (64 - slot_count_bits));
+        }
+
+        [[nodiscard]]
+        size_t get_probe_distance(size_t slot_index, uint64_t hash) const {
+            return (slot_index - get_home_slot(hash)) & (slots.size() - 1);
+        }
+
+        template<typename LookupKey>
+        [[nodiscard]]
+        size_t find_pair_index(const LookupKey& key) const {
+            return find_pair_index(key, hash_key(key));
+        }
+
+        template<typename LookupKey>
+        [[nodiscard]]
+        size_t find_pair_index(const LookupKey& key, uint64_t hash) const {
+            for(size_t slot_index = get_home_slot(hash), distance = 0;; slot_index = (slot_index + 1) & (slots.size() - 1), distance++) {
+                const auto& slot = slots[slot_index];
+
+                if(slot.pair_index == EMPTY_SLOT || get_probe_distance(slot_index, slot.hash) < distance)
+                    return EMPTY_SLOT;
+
+                if(slot.hash == hash && pairs[slot.pair_index].first == key)
+                    return slot.pair_index;
+            }
+        }
+
+        /**
+         * Inserts the pair index, moving the slots closer to their home ones
+         * than the inserted one further, so probe sequences stay short.
+         */
+        void insert_slot(Slot inserted_slot) {
+            for(size_t slot_index = get_home_slot(inserted_slot.hash), distance = 0;; slot_index = (slot_index + 1) & (slots.size() - 1), distance++) {
+                auto& slot = slots[slot_index];
+
+                if(slot.pair_index == EMPTY_SLOT) {
+                    slot = inserted_slot;
+                    return;
+                }
+
+                auto slot_distance = get_probe_distance(slot_index, slot.hash);
+                if(slot_distance < distance) {
+                    std::swap(slot, inserted_slot);
+                    distance = slot_distance;
+                }
+            }
+        }
+
+        void rehash(unsigned int new_slot_count_bits) {
+            slot_count_bits = new_slot_count_bits;
+            slots.assign(size_t { 1 } << slot_count_bits, Slot {});
+
+            for(size_t pair_index = 0; pair_index < pairs.size(); pair_index++) {
+                insert_slot({ pair_index, hash_key(pairs[pair_index].first) });
+            }
+        }
+
+        [[nodiscard]]
+        static bool exceeds_max_load(size_t pair_count, size_t slot_count) {
+            return pair_count * 5 > slot_count * 4;
+        }
     public:
         explicit Dictionary() = default;
 
         virtual ~Dictionary() = default;
 
-        std::pair<Key, Value>& find_mutable_pair(const Key& key) {
-            for(auto& pair : get_pairs()) {
-                if(pair.first == key) {
-                    return pair;
-                }
-            }
+        /**
+         * Returns the hash of the key the lookups use. A caller that needs
+         * the hash too, e.g. to choose a shard, can compute it once and pass
+         * it to find().
+         *
+         * @param key The key, or anything comparable to it and hashed the same way
+         * @return The hash of the key
+         */
+        template<typename LookupKey = Key>
+        [[nodiscard]]
+        static uint64_t hash_key(const LookupKey& key) {
+            return static_cast<uint64_t>(Hash {}(key)) * 0x9E3779B97F4A7C15ull;
+        }
+
+        template<typename LookupKey = Key>
+        std::pair<Key, Value>& find_mutable_pair(const LookupKey& key) {
+            auto pair_index = find_pair_index(key);
+            if(pair_index == EMPTY_SLOT)
+                throw std::runtime_error("Trying to get value from dictionary by key, which is not present.");
 
-            throw std::runtime_error("Trying to get value from dictionary by key, which is not present.");
+            return pairs[pair_index];
         }
 
-        const auto& find_pair(const Key& key) const {
-            for(const auto& pair : get_pairs()) {
-                if(pair.first == key) {
-                    return pair;
-                }
-            }
+        template<typename LookupKey = Key>
+        const std::pair<Key, Value>& find_pair(const LookupKey& key) const {
+            auto pair_index = find_pair_index(key);
+            if(pair_index == EMPTY_SLOT)
+                throw std::runtime_error("Trying to get value from dictionary by key, which is not present.");
 
-            throw std::runtime_error("Trying to get value from dictionary by key, which is not present.");
+            return pairs[pair_index];
         }
 
+        /**
+         * Returns a pointer to the value of the key without throwing.
+         *
+         * @param key The key, or anything comparable to it and hashed the same way, e.g. a string view for string keys
+         * @return The pointer to the value, or nullptr if the key is not present
+         */
+        template<typename LookupKey = Key>
         [[nodiscard]]
-        bool has(const Key& key) const {
-            try {
-                find_pair(key);
-                return true;
-            } catch(const std::runtime_error&) {
-                return false;
-            }
+        Value* find(const LookupKey& key) {
+            auto pair_index = find_pair_index(key);
+            return pair_index == EMPTY_SLOT ? nullptr : &pairs[pair_index].second;
         }
 
-        void put(const Key& key, Value value) {
-            if(has(key)) {
-                pairs.erase(std::remove_if(pairs.begin(), pairs.end(), [&](const auto& pair) {
-                    return pair.first == key;
-                }), pairs.end());
-            }
+        template<typename LookupKey = Key>
+        [[nodiscard]]
+        const Value* find(const LookupKey& key) const {
+            auto pair_index = find_pair_index(key);
+            return pair_index == EMPTY_SLOT ? nullptr : &pairs[pair_index].second;
+        }
 
-            pairs.push_back(std::pair<Key, Value>{key, value});
+        /**
+         * Returns a pointer to the value of the key without hashing the key again.
+         *
+         * @param key The key, or anything comparable to it and hashed the same way
+         * @param hash The hash of the key returned by hash_key()
+         * @return The pointer to the value, or nullptr if the key is not present
+         */
+        template<typename LookupKey = Key>
+        [[nodiscard]]
+        const Value* find(const LookupKey& key, uint64_t hash) const {
+            auto pair_index = find_pair_index(key, hash);
+            return pair_index == EMPTY_SLOT ? nullptr : &pairs[pair_index].second;
         }
 
+        /**
+         * Returns a copy of the value of the key without throwing.
+         *
+         * @param key The key, or anything comparable to it and hashed the same way
+         * @return The value, or nothing if the key is not present
+         */
+        template<typename LookupKey = Key>
         [[nodiscard]]
-        std::vector<Key> get_keys() const {
-            std::vector<Key> dictionary_keys;
-            for(const auto& pair : get_pairs()) {
-                dictionary_keys.push_back(pair.first);
-            }
+        std::optional<Value> try_get(const LookupKey& key) const {
+            if(const auto* value = find(key))
+                return *value;
 
-            return dictionary_keys;
+            return std::nullopt;
         }
 
+        template<typename LookupKey = Key>
         [[nodiscard]]
-        std::vector<Value> get_values() const {
-            std::vector<Value> dictionary_keys;
-            for(const auto& pair : get_pairs()) {
-                dictionary_keys.push_back(pair.second);
+        bool has(const LookupKey& key) const {
+            return find_pair_index(key) != EMPTY_SLOT;
+        }
+
+        void put(const Key& key, Value value) {
+            if(auto* existing_value = find(key)) {
+                *existing_value = std::move(value);
+                return;
             }
 
-            return dictionary_keys;
+            if(exceeds_max_load(pairs.size() + 1, slots.size()))
+                rehash(slot_count_bits + 1);
+
+            pairs.emplace_back(key, std::move(value));
+            insert_slot({ pairs.size() - 1, hash_key(pairs.back().first) });
+        }
+
+        void reserve(size_t pair_count) {
+            pairs.reserve(pair_count);
+
+            auto new_slot_count_bits = slot_count_bits;
+            while(exceeds_max_load(pair_count, size_t { 1 } << new_slot_count_bits))
+                new_slot_count_bits++;
+
+            if(new_slot_count_bits != slot_count_bits)
+                rehash(new_slot_count_bits);
+        }
+
+        [[nodiscard]]
+        auto get_keys() const {
+            return std::views::keys(pairs);
+        }
+
+        [[nodiscard]]
+        auto get_values() const {
+            return std::views::values(pairs);
         }
 
         [[nodiscard]]
-        Value& get(const Key& key) {
+        auto get_values() {
+            return std::views::values(pairs);
+        }
+
+        template<typename LookupKey = Key>
+        [[nodiscard]]
+        Value& get(const LookupKey& key) {
             return find_mutable_pair(key).second;
         }
 
+        template<typename LookupKey = Key>
         [[nodiscard]]
-        const Value& get(const Key& key) const {
+        const Value& get(const LookupKey& key) const {
             return find_pair(key).second;
         }
 
+        template<typename LookupKey = Key>
         [[nodiscard]]
-        const Value& operator[](const Key& key) const {
+        const Value& operator[](const LookupKey& key) const {
             return get(key);
         }
 
+        template<typename LookupKey = Key>
         [[nodiscard]]
-        Value& operator[](const Key& key) {
+        Value& operator[](const LookupKey& key) {
             return get(key);
         }
 
-        [[maybe_unused]] [[nodiscard]]
-        auto get_pairs() {
-            return pairs;
-        }
-
         [[nodiscard]]
         const auto& get_pairs() const {
             return pairs;
@@ -119,4 +292,4 @@ namespace PROJECT_NAME {
             return pairs.size();
         }
     };
-}
\ No newline at end of file
+}
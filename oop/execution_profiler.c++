@@ -0,0 +1,92 @@
+#include <execution_profiler.h++>
+#include <utils/json.h++>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std::string_literals;
+
+namespace PROJECT_NAME {
+    ExecutionProfiler::ExecutionProfiler(unsigned int result_sampling_interval) : result_sampling_interval(result_sampling_interval) {
+        //
+    }
+
+    int ExecutionProfiler::digit_bucket_of(int operand_digits) {
+        return static_cast<int>(std::bit_ceil(static_cast<unsigned int>(std::max(operand_digits, MINIMAL_DIGIT_BUCKET))));
+    }
+
+    void ExecutionProfiler::record_command(const std::string& operation, int operand_digits, uint64_t nanoseconds) {
+        operation_latencies[operation][digit_bucket_of(operand_digits)].record(nanoseconds);
+    }
+
+    void ExecutionProfiler::record_result_size(uint64_t program_counter, int result_digits, bool force) {
+        if(force || (result_sampling_interval != 0 && program_counter % result_sampling_interval == 0)) {
+            if(result_growth.empty() || result_growth.back().first != program_counter)
+                result_growth.emplace_back(program_counter, result_digits);
+        }
+    }
+
+    void ExecutionProfiler::reset() {
+        operation_latencies.clear();
+        result_growth.clear();
+    }
+
+    LatencyHistogram ExecutionProfiler::get_latencies(const std::string& operation) const {
+        LatencyHistogram merged_latencies;
+
+        if(auto profile = operation_latencies.find(operation); profile != operation_latencies.end()) {
+            for(const auto& [digit_bucket, latencies] : profile->second) {
+                merged_latencies.merge(latencies);
+            }
+        }
+
+        return merged_latencies;
+    }
+
+    const std::vector<std::pair<uint64_t, int>>& ExecutionProfiler::get_result_growth() const {
+        return result_growth;
+    }
+
+    std::string ExecutionProfiler::to_json() const {
+        std::stringstream json;
+        json << "{\n  \"operations\": {";
+
+        bool first_operation = true;
+        for(const auto& [operation, digit_buckets] : operation_latencies) {
+            json << (first_operation ? "\n" : ",\n") << "    \"" << escape_json_string(operation) << "\": { ";
+            write_latencies_json(json, get_latencies(operation));
+            json << ", \"operand_digits\": [";
+
+            bool first_bucket = true;
+            for(const auto& [digit_bucket, latencies] : digit_buckets) {
+                json << (first_bucket ? "\n" : ",\n") << "      { \"max_digits\": " << digit_bucket << ", ";
+                write_latencies_json(json, latencies);
+                json << " }";
+                first_bucket = false;
+            }
+
+            json << "\n    ] }";
+            first_operation = false;
+        }
+
+        json << "\n  },\n  \"result_growth\": [";
+
+        bool first_sample = true;
+        for(const auto& [program_counter, result_digits] : result_growth) {
+            json << (first_sample ? "" : ", ") << "{ \"command\": " << program_counter << ", \"digits\": " << result_digits << " }";
+            first_sample = false;
+        }
+
+        json << "]\n}\n";
+        return json.str();
+    }
+
+    void ExecutionProfiler::export_json(const std::string& filename) const {
+        std::ofstream json_file { filename, std::ios::trunc };
+
+        if(!json_file.is_open())
+            throw std::runtime_error("Cannot open file '"s + filename + "' for writing the profiling report");
+
+        json_file << to_json();
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * -----------------------------------------------
+ * Execution Profiler
+ * -----------------------------------------------
+ * Collects per-operation statistics of the big
+ * integer command executor: counts, total time and
+ * latency percentiles split by the operand size,
+ * plus the growth of the result over time.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <utils/latency_histogram.h++>
+
+namespace PROJECT_NAME {
+    class ExecutionProfiler {
+        static constexpr int MINIMAL_DIGIT_BUCKET = 16;
+
+        std::map<std::string, std::map<int, LatencyHistogram>> operation_latencies;
+        std::vector<std::pair<uint64_t, int>> result_growth;
+        unsigned int result_sampling_interval;
+    public:
+        /**
+         * Creates a new profiler.
+         *
+         * @param result_sampling_interval A count of commands between result size samples
+         */
+        explicit ExecutionProfiler(unsigned int result_sampling_interval = 1024);
+
+        /**
+         * Returns the upper bound of the digit-count bucket the passed operand falls in.
+         * Buckets are powers of two, starting from 16 digits.
+         *
+         * @param operand_digits A count of digits of the operand
+         * @return The maximal count of digits in the bucket
+         */
+        [[nodiscard]]
+        static int digit_bucket_of(int operand_digits);
+
+        /**
+         * Records a single executed command.
+         *
+         * @param operation The operation name
+         * @param operand_digits A count of digits of the operand
+         * @param nanoseconds The time the operation took
+         */
+        void record_command(const std::string& operation, int operand_digits, uint64_t nanoseconds);
+
+        /**
+         * Records the size of the result after the command with the passed number,
+         * if the command falls on the sampling interval.
+         *
+         * @param program_counter A count of commands executed so far
+         * @param result_digits A count of digits of the result
+         * @param force Records the sample regardless of the sampling interval
+         */
+        void record_result_size(uint64_t program_counter, int result_digits, bool force = false);
+
+        /**
+         * Forgets everything recorded so far.
+         */
+        void reset();
+
+        /**
+         * Returns the latencies of the operation, merged across all operand sizes.
+         * @param operation The operation name
+         * @return The latency histogram, empty if the operation was never recorded
+         */
+        [[nodiscard]]
+        LatencyHistogram get_latencies(const std::string& operation) const;
+
+        [[nodiscard]]
+        const std::vector<std::pair<uint64_t, int>>& get_result_growth() const;
+
+        /**
+         * Renders the report as a JSON document.
+         * @return The JSON report
+         */
+        [[nodiscard]]
+        std::string to_json() const;
+
+        /**
+         * Writes the JSON report to a file.
+         * @throws std::runtime_error When the file cannot be opened for writing
+         * @param filename The file where the report will be written to
+         */
+        void export_json(const std::string& filename) const;
+    };
+}
@@ -0,0 +1,75 @@
+#include <log_limiter.h++>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+using namespace std::string_literals;
+
+namespace PROJECT_NAME {
+    std::string with_suppressed_count(std::string message, uint64_t suppressed_count) {
+        if(suppressed_count != 0)
+            message += " ("s + std::to_string(suppressed_count) + " similar messages suppressed)";
+
+        return message;
+    }
+
+    TokenBucketLimiter::TokenBucketLimiter(double rate, double burst) : rate(rate), burst(burst), tokens(burst) {
+        if(!(rate > 0) || !(burst > 0))
+            throw std::invalid_argument("Token bucket rate and burst should be positive, but they are "s + std::to_string(rate) + " and " + std::to_string(burst));
+    }
+
+    bool TokenBucketLimiter::try_acquire(uint64_t& suppressed_count) {
+        std::lock_guard lock { bucket_mutex };
+
+        auto now = std::chrono::steady_clock::now();
+        tokens = std::min(burst, tokens + std::chrono::duration<double>(now - refilled_at).count() * rate);
+        refilled_at = now;
+
+        if(tokens < 1) {
+            this->suppressed_count++;
+            return false;
+        }
+
+        tokens--;
+        suppressed_count = std::exchange(this->suppressed_count, 0);
+        return true;
+    }
+
+    SamplingLimiter::SamplingLimiter(uint64_t first_count, uint64_t sampling_interval) : first_count(first_count), sampling_interval(sampling_interval) {
+        if(sampling_interval == 0)
+            throw std::invalid_argument("Sampling interval cannot be 0");
+    }
+
+    bool SamplingLimiter::try_acquire(uint64_t& suppressed_count) {
+        auto attempt = attempts_count.fetch_add(1, std::memory_order_relaxed);
+
+        if(attempt >= first_count && (attempt - first_count + 1) % sampling_interval != 0) {
+            this->suppressed_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        suppressed_count = this->suppressed_count.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    DeduplicatingLimiter::DeduplicatingLimiter(std::chrono::steady_clock::duration summary_interval) : summary_interval(summary_interval) {
+        //
+    }
+
+    bool DeduplicatingLimiter::try_acquire(const std::string& message, uint64_t& repeated_count) {
+        std::lock_guard lock { deduplication_mutex };
+        auto now = std::chrono::steady_clock::now();
+
+        if(message == previous_message && now - previous_message_logged_at < summary_interval) {
+            this->repeated_count++;
+            return false;
+        }
+
+        repeated_count = std::exchange(this->repeated_count, 0);
+        bool message_is_new = message != previous_message;
+
+        previous_message = message;
+        previous_message_logged_at = now;
+        return message_is_new;
+    }
+}
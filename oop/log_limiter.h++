@@ -0,0 +1,148 @@
+/*
+ * -----------------------------------------------
+ * Log Limiters
+ * -----------------------------------------------
+ * Keep log storms from dominating the runtime and
+ * the disk. Every limited call site gets its own
+ * static limiter: a token bucket, a sampler logging
+ * the first messages and then every M-th one, or
+ * a deduplicator collapsing repeated messages into
+ * a single summary line.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/**
+ * Logs at most BURST messages at once and RATE messages per second on average.
+ * The next logged message tells how many were suppressed before it.
+ */
+#define OOP_LOG_RATE_LIMITED(LOGGER, LEVEL, RATE, BURST, MESSAGE) do { \
+    if constexpr((LEVEL).is_compiled_in()) { \
+        static PROJECT_NAME::TokenBucketLimiter oop_log_limiter(RATE, BURST); \
+        uint64_t oop_log_suppressed_count = 0; \
+        if((LOGGER).is_enabled(LEVEL) && oop_log_limiter.try_acquire(oop_log_suppressed_count)) \
+            (LOGGER).log(PROJECT_NAME::with_suppressed_count((MESSAGE), oop_log_suppressed_count), (LEVEL)); \
+    } \
+} while(false)
+
+/**
+ * Logs the first FIRST messages and then every EVERY-th one.
+ * The next logged message tells how many were suppressed before it.
+ */
+#define OOP_LOG_SAMPLED(LOGGER, LEVEL, FIRST, EVERY, MESSAGE) do { \
+    if constexpr((LEVEL).is_compiled_in()) { \
+        static PROJECT_NAME::SamplingLimiter oop_log_limiter(FIRST, EVERY); \
+        uint64_t oop_log_suppressed_count = 0; \
+        if((LOGGER).is_enabled(LEVEL) && oop_log_limiter.try_acquire(oop_log_suppressed_count)) \
+            (LOGGER).log(PROJECT_NAME::with_suppressed_count((MESSAGE), oop_log_suppressed_count), (LEVEL)); \
+    } \
+} while(false)
+
+/**
+ * Logs the message unless it is the same as the previous one of this call site.
+ * When a different message comes, or the same one after SUMMARY_INTERVAL, a summary
+ * line telling how many times the previous message was repeated is logged first.
+ */
+#define OOP_LOG_DEDUPLICATED(LOGGER, LEVEL, SUMMARY_INTERVAL, MESSAGE) do { \
+    if constexpr((LEVEL).is_compiled_in()) { \
+        static PROJECT_NAME::DeduplicatingLimiter oop_log_limiter(SUMMARY_INTERVAL); \
+        if((LOGGER).is_enabled(LEVEL)) { \
+            std::string oop_log_message = (MESSAGE); \
+            uint64_t oop_log_repeated_count = 0; \
+            bool oop_log_accepted = oop_log_limiter.try_acquire(oop_log_message, oop_log_repeated_count); \
+            if(oop_log_repeated_count != 0) \
+                (LOGGER).log("Previous message repeated "s + std::to_string(oop_log_repeated_count) + " times", (LEVEL)); \
+            if(oop_log_accepted) \
+                (LOGGER).log(oop_log_message, (LEVEL)); \
+        } \
+    } \
+} while(false)
+
+namespace PROJECT_NAME {
+    /**
+     * Appends a note about suppressed messages to the message.
+     *
+     * @param message The message
+     * @param suppressed_count A count of messages suppressed before it
+     * @return The message with the note
+     */
+    std::string with_suppressed_count(std::string message, uint64_t suppressed_count);
+
+    class TokenBucketLimiter {
+        double rate, burst, tokens;
+        std::chrono::steady_clock::time_point refilled_at = std::chrono::steady_clock::now();
+        uint64_t suppressed_count = 0;
+        std::mutex bucket_mutex;
+    public:
+        /**
+         * Creates a new token bucket, which is full at the beginning.
+         *
+         * @throws std::invalid_argument When the rate or the burst is not positive
+         * @param rate A count of tokens added per second
+         * @param burst A maximal count of tokens
+         */
+        TokenBucketLimiter(double rate, double burst);
+
+        /**
+         * Takes a token if there is any.
+         *
+         * @param suppressed_count Set to a count of failed attempts since the previous successful one
+         * @return True if a token was taken
+         */
+        bool try_acquire(uint64_t& suppressed_count);
+    };
+
+    class SamplingLimiter {
+        uint64_t first_count, sampling_interval;
+        std::atomic<uint64_t> attempts_count = 0, suppressed_count = 0;
+    public:
+        /**
+         * Creates a new sampler.
+         *
+         * @throws std::invalid_argument When the sampling interval is 0
+         * @param first_count A count of first attempts that all succeed
+         * @param sampling_interval After them, only every 'sampling_interval'-th attempt succeeds
+         */
+        SamplingLimiter(uint64_t first_count, uint64_t sampling_interval);
+
+        /**
+         * Makes an attempt.
+         *
+         * @param suppressed_count Set to a count of failed attempts since the previous successful one
+         * @return True if the attempt succeeded
+         */
+        bool try_acquire(uint64_t& suppressed_count);
+    };
+
+    class DeduplicatingLimiter {
+        std::chrono::steady_clock::duration summary_interval;
+        std::string previous_message;
+        std::chrono::steady_clock::time_point previous_message_logged_at;
+        uint64_t repeated_count = 0;
+        std::mutex deduplication_mutex;
+    public:
+        /**
+         * Creates a new deduplicator.
+         * @param summary_interval An interval after which a repeated message is summarized even if it keeps repeating
+         */
+        explicit DeduplicatingLimiter(std::chrono::steady_clock::duration summary_interval = std::chrono::seconds(10));
+
+        /**
+         * Checks whether the message differs from the previous one.
+         *
+         * @param message The message
+         * @param repeated_count Set to a count of repeats of the previous message to be summarized now, usually 0
+         * @return True if the message should be logged
+         */
+        bool try_acquire(const std::string& message, uint64_t& repeated_count);
+    };
+}
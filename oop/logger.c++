@@ -1,36 +1,258 @@
 #include <logger.h++>
+#include <charconv>
+#include <limits>
 
 namespace PROJECT_NAME {
+    unsigned int get_thread_number() {
+        static std::atomic<unsigned int> next_thread_number = 1;
+        thread_local unsigned int thread_number = next_thread_number++;
+        return thread_number;
+    }
+
     MessageFormatter::MessageFormatter(std::string message_format) : message_format(std::move(message_format)) {
-        //
+        static constexpr std::pair<std::string_view, TokenKind> BUILT_IN_PATTERNS[] = {
+            { TIME_REPLACING_TAG, TokenKind::TIME },
+            { MILLISECONDS_REPLACING_TAG, TokenKind::MILLISECONDS },
+            { LEVEL_REPLACING_TAG, TokenKind::LEVEL },
+            { MESSAGE_REPLACING_TAG, TokenKind::MESSAGE },
+            { THREAD_REPLACING_TAG, TokenKind::THREAD },
+        };
+
+        std::vector<std::pair<std::string, PatternRenderer>> custom_patterns;
+        {
+            std::lock_guard lock { get_custom_patterns_mutex() };
+            custom_patterns = get_custom_patterns();
+        }
+
+        std::string literal;
+        std::string_view format = this->message_format;
+        size_t position = 0;
+
+        while(position < format.size()) {
+            if(format.substr(position).starts_with(PATTERN_PREFIX)) {
+                auto pattern = format.substr(position + PATTERN_PREFIX.size());
+                Token matched_token { TokenKind::LITERAL, "", nullptr };
+                size_t matched_length = 0;
+
+                for(const auto& [name, kind] : BUILT_IN_PATTERNS) {
+                    if(pattern.starts_with(name) && name.size() > matched_length) {
+                        matched_token = { kind, "", nullptr };
+                        matched_length = name.size();
+                    }
+                }
+
+                for(const auto& [name, renderer] : custom_patterns) {
+                    if(pattern.starts_with(name) && name.size() > matched_length) {
+                        matched_token = { TokenKind::CUSTOM, "", renderer };
+                        matched_length = name.size();
+                    }
+                }
+
+                if(matched_length != 0) {
+                    if(!literal.empty())
+                        tokens.push_back({ TokenKind::LITERAL, std::move(literal), nullptr });
+
+                    literal.clear();
+                    tokens.push_back(std::move(matched_token));
+                    position += PATTERN_PREFIX.size() + matched_length;
+                    continue;
+                }
+            }
+
+            literal += format[position++];
+        }
+
+        if(!literal.empty())
+            tokens.push_back({ TokenKind::LITERAL, std::move(literal), nullptr });
+    }
+
+    std::vector<std::pair<std::string, PatternRenderer>>& MessageFormatter::get_custom_patterns() {
+        static std::vector<std::pair<std::string, PatternRenderer>> custom_patterns;
+        return custom_patterns;
+    }
+
+    std::mutex& MessageFormatter::get_custom_patterns_mutex() {
+        static std::mutex custom_patterns_mutex;
+        return custom_patterns_mutex;
     }
 
-    std::string MessageFormatter::format(const std::string& message, LogLevel& level) const {
-        std::string formatted_message = message_format;
+    void MessageFormatter::register_pattern(const std::string& name, PatternRenderer renderer) {
+        if(name.empty())
+            throw std::invalid_argument("Message format pattern name cannot be empty");
 
-        if(formatted_message.find(TIME_REPLACING_TAG) != std::string::npos) {
-            std::stringstream stringed_time;
-            auto timestamp = std::time(nullptr);
-            auto time_object = std::localtime(&timestamp);
-            stringed_time << std::put_time(time_object, "%H:%M:%S");
-            formatted_message.replace(formatted_message.find(TIME_REPLACING_TAG), TIME_REPLACING_TAG.length(), stringed_time.str());
+        std::lock_guard lock { get_custom_patterns_mutex() };
+        auto& custom_patterns = get_custom_patterns();
+
+        for(auto& [existing_name, existing_renderer] : custom_patterns) {
+            if(existing_name == name) {
+                existing_renderer = std::move(renderer);
+                return;
+            }
         }
 
-        if(formatted_message.find(LEVEL_REPLACING_TAG) != std::string::npos) {
-            formatted_message.replace(formatted_message.find(LEVEL_REPLACING_TAG), LEVEL_REPLACING_TAG.length(), level.get_tag());
+        custom_patterns.emplace_back(name, std::move(renderer));
+    }
+
+    void MessageFormatter::append_time(std::string& buffer, std::chrono::system_clock::time_point timestamp) {
+        static constexpr size_t TIME_LENGTH = 8;
+        thread_local std::time_t cached_second = -1;
+        thread_local char cached_time[TIME_LENGTH + 1];
+
+        auto second = std::chrono::system_clock::to_time_t(timestamp);
+        if(second != cached_second) {
+            std::tm time_object {};
+            localtime_r(&second, &time_object);
+            std::strftime(cached_time, sizeof(cached_time), "%H:%M:%S", &time_object);
+            cached_second = second;
         }
 
-        if(formatted_message.find(MESSAGE_REPLACING_TAG) != std::string::npos) {
-            formatted_message.replace(formatted_message.find(MESSAGE_REPLACING_TAG), MESSAGE_REPLACING_TAG.length(), message);
+        buffer.append(cached_time, TIME_LENGTH);
+    }
+
+    std::string MessageFormatter::format(const std::string& message, const LogLevel& level) const {
+        return format(message, level, std::chrono::system_clock::now());
+    }
+
+    std::string MessageFormatter::format(const std::string& message, const LogLevel& level, std::chrono::system_clock::time_point timestamp) const {
+        std::string formatted_message;
+        format_to(formatted_message, message, level, timestamp);
+        return formatted_message;
+    }
+
+    void MessageFormatter::format_to(std::string& buffer, const std::string& message, const LogLevel& level, std::chrono::system_clock::time_point timestamp) const {
+        for(const auto& token : tokens) {
+            switch(token.kind) {
+                case TokenKind::LITERAL:
+                    buffer.append(token.literal);
+                    break;
+                case TokenKind::TIME:
+                    append_time(buffer, timestamp);
+                    break;
+                case TokenKind::MILLISECONDS: {
+                    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count() % 1000;
+                    buffer.push_back(static_cast<char>('0' + milliseconds / 100));
+                    buffer.push_back(static_cast<char>('0' + milliseconds / 10 % 10));
+                    buffer.push_back(static_cast<char>('0' + milliseconds % 10));
+                    break;
+                }
+                case TokenKind::LEVEL:
+                    buffer.append(level.get_tag());
+                    break;
+                case TokenKind::MESSAGE:
+                    buffer.append(message);
+                    break;
+                case TokenKind::THREAD: {
+                    char digits[std::numeric_limits<unsigned int>::digits10 + 1];
+                    auto result = std::to_chars(digits, digits + sizeof(digits), get_thread_number());
+                    buffer.append(digits, result.ptr);
+                    break;
+                }
+                case TokenKind::CUSTOM:
+                    token.renderer(buffer, message, level, timestamp);
+                    break;
+            }
         }
 
-        return formatted_message + '\n';
+        buffer.push_back('\n');
+    }
+
+    const std::string& MessageFormatter::get_message_format() const {
+        return message_format;
+    }
+
+    namespace {
+        /**
+         * Lends the formatting buffer of the calling thread, so logging does not allocate.
+         * If the buffer is already lent, e.g. a sink or a pattern renderer logs through
+         * another logger, a buffer of its own is used instead of overwriting the lent one.
+         */
+        class FormattingBuffer {
+            static inline thread_local std::string thread_buffer;
+            static inline thread_local bool thread_buffer_lent = false;
+
+            std::string own_buffer;
+            bool lends_thread_buffer;
+        public:
+            FormattingBuffer() : lends_thread_buffer(!thread_buffer_lent) {
+                if(lends_thread_buffer) {
+                    thread_buffer_lent = true;
+                    thread_buffer.clear();
+                }
+            }
+
+            FormattingBuffer(const FormattingBuffer&) = delete;
+            FormattingBuffer& operator=(const FormattingBuffer&) = delete;
+
+            ~FormattingBuffer() {
+                if(lends_thread_buffer)
+                    thread_buffer_lent = false;
+            }
+
+            std::string& get() {
+                return lends_thread_buffer ? thread_buffer : own_buffer;
+            }
+        };
     }
 
     AbstractLogger::AbstractLogger(MessageFormatter formatter) : formatter(std::move(formatter)) {
         //
     }
 
+    void AbstractLogger::log(const std::string& message, LogLevel level) {
+        if(!is_enabled(level))
+            return;
+
+        FormattingBuffer formatting_buffer;
+        auto& formatted_message = formatting_buffer.get();
+
+        auto metrics = get_active_metrics();
+        if(!metrics) {
+            formatter.format_to(formatted_message, message, level, std::chrono::system_clock::now());
+            write(formatted_message);
+            return;
+        }
+
+        auto formatting_started_at = std::chrono::steady_clock::now();
+        formatter.format_to(formatted_message, message, level, std::chrono::system_clock::now());
+        auto writing_started_at = std::chrono::steady_clock::now();
+        write(formatted_message);
+        auto writing_finished_at = std::chrono::steady_clock::now();
+
+        metrics->record(formatted_message.size(), std::chrono::duration_cast<std::chrono::nanoseconds>(writing_started_at - formatting_started_at).count(), std::chrono::duration_cast<std::chrono::nanoseconds>(writing_finished_at - writing_started_at).count());
+        metrics->record_caller(std::chrono::duration_cast<std::chrono::nanoseconds>(writing_finished_at - formatting_started_at).count());
+    }
+
+    void AbstractLogger::enable_metrics() {
+        if(!metrics)
+            metrics = std::make_unique<LoggerMetrics>();
+
+        active_metrics.store(metrics.get(), std::memory_order_release);
+    }
+
+    void AbstractLogger::disable_metrics() {
+        active_metrics.store(nullptr, std::memory_order_release);
+    }
+
+    LoggerMetricsSnapshot AbstractLogger::snapshot() const {
+        return metrics ? metrics->snapshot() : LoggerMetricsSnapshot {};
+    }
+
+    void AbstractLogger::flush() {
+        //
+    }
+
+    void AbstractLogger::set_level(LogLevel level) {
+        minimal_severity.store(level.get_severity(), std::memory_order_relaxed);
+    }
+
+    void AbstractLogger::trace(const std::string& message) {
+        log(message, TRACE);
+    }
+
+    void AbstractLogger::debug(const std::string& message) {
+        log(message, DEBUG);
+    }
+
     void AbstractLogger::info(const std::string& message) {
         log(message, INFO);
     }
@@ -47,31 +269,47 @@ namespace PROJECT_NAME {
         //
     }
 
-    void ConsoleLogger::log(const std::string &message, LogLevel level) {
-        std::cout << formatter.format(message, level);
-    };
+    void ConsoleLogger::write(const std::string& formatted_message) {
+        std::cout << formatted_message;
+    }
+
+    void ConsoleLogger::flush() {
+        std::cout.flush();
+    }
 
     FileLogger::FileLogger(const std::string& logger_filename, MessageFormatter formatter) : AbstractLogger(std::move(formatter)) {
         file_output_stream = std::ofstream(logger_filename);
     }
 
-    void FileLogger::log(const std::string &message, LogLevel level) {
-        file_output_stream << formatter.format(message, level);
-    };
+    void FileLogger::write(const std::string& formatted_message) {
+        file_output_stream << formatted_message;
+    }
+
+    void FileLogger::flush() {
+        file_output_stream.flush();
+    }
 
-    DoubleLogger::DoubleLogger(const MessageFormatter& formatter, const std::string& logger_filename) {
+    DoubleLogger::DoubleLogger(const MessageFormatter& formatter, const std::string& logger_filename) : AbstractLogger(formatter) {
         if(!logger_filename.empty())
             file_logger = std::make_unique<FileLogger>(logger_filename, formatter);
 
         console_logger = std::make_unique<ConsoleLogger>(formatter);
     }
 
-    void DoubleLogger::log(const std::string &message, LogLevel level) {
+    void DoubleLogger::write(const std::string& formatted_message) {
+        if(file_logger)
+            file_logger->write(formatted_message);
+
+        if(console_logger)
+            console_logger->write(formatted_message);
+    }
+
+    void DoubleLogger::flush() {
         if(file_logger)
-            file_logger->log(message, level);
+            file_logger->flush();
 
         if(console_logger)
-            console_logger->log(message, level);
+            console_logger->flush();
     }
 
     FileLogger LoggerFactory::create_file_logger(const std::string& logger_filename, const MessageFormatter& formatter) {
@@ -23,43 +23,196 @@
 #include <fstream>
 #include <filesystem>
 #include <stdexcept>
+#include <memory>
+#include <atomic>
+#include <type_traits>
+#include <logger_metrics.h++>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <vector>
 
-#define RegisterLogLevel(NAME) const LogLevel NAME(#NAME)
+#define RegisterLogLevel(NAME, SEVERITY) inline constexpr LogLevel NAME(#NAME, SEVERITY)
+
+#define OOP_LOG_LEVEL_TRACE 0
+#define OOP_LOG_LEVEL_DEBUG 1
+#define OOP_LOG_LEVEL_INFO 2
+#define OOP_LOG_LEVEL_WARNING 3
+#define OOP_LOG_LEVEL_ERROR 4
+
+/**
+ * The minimal severity of the messages logged through the OOP_LOG macros.
+ * Calls with lower levels are eliminated at compile time, including
+ * the evaluation of their messages. Define it before compiling, e.g.
+ * -DOOP_LOG_MIN_LEVEL=OOP_LOG_LEVEL_INFO for release builds.
+ */
+#ifndef OOP_LOG_MIN_LEVEL
+#define OOP_LOG_MIN_LEVEL OOP_LOG_LEVEL_TRACE
+#endif
+
+/**
+ * Logs the message only if the level is enabled both at compile time
+ * and in the logger. The message expression is not evaluated otherwise.
+ */
+#define OOP_LOG(LOGGER, LEVEL, MESSAGE) do { \
+    if constexpr((LEVEL).is_compiled_in()) { \
+        if((LOGGER).is_enabled(LEVEL)) \
+            (LOGGER).log((MESSAGE), (LEVEL)); \
+    } \
+} while(false)
+
+#define OOP_LOG_TRACE(LOGGER, MESSAGE) OOP_LOG(LOGGER, PROJECT_NAME::TRACE, MESSAGE)
+#define OOP_LOG_DEBUG(LOGGER, MESSAGE) OOP_LOG(LOGGER, PROJECT_NAME::DEBUG, MESSAGE)
+#define OOP_LOG_INFO(LOGGER, MESSAGE) OOP_LOG(LOGGER, PROJECT_NAME::INFO, MESSAGE)
+#define OOP_LOG_WARNING(LOGGER, MESSAGE) OOP_LOG(LOGGER, PROJECT_NAME::WARNING, MESSAGE)
+#define OOP_LOG_ERROR(LOGGER, MESSAGE) OOP_LOG(LOGGER, PROJECT_NAME::ERROR, MESSAGE)
 
 using namespace std::string_literals;
 
 namespace PROJECT_NAME {
     class LogLevel final {
-        std::string tag;
+        struct BorrowedTag {};
+
+        std::string_view tag;
+        unsigned int severity;
+
+        constexpr LogLevel(BorrowedTag, std::string_view tag, unsigned int severity) : tag(tag), severity(severity) {
+            //
+        }
     public:
-        LogLevel(std::string tag) : tag(std::move(tag)) {
+        /**
+         * Creates a new log level. Levels are compared by their severity only.
+         * The level refers to its tag without copying it, so the tag should be
+         * known at compile time, e.g. a string literal, and the constructor
+         * rejects anything else.
+         *
+         * @param tag The level name written to logs
+         * @param severity The level severity, the greater the more important
+         */
+        consteval LogLevel(std::string_view tag, unsigned int severity) : tag(tag), severity(severity) {
             //
         }
 
+        /**
+         * Creates a log level with a tag known only at runtime, e.g. read from
+         * a binary log. The level refers to the tag, so the tag should outlive
+         * the level and every record logged with it.
+         *
+         * @param tag The level name written to logs
+         * @param severity The level severity, the greater the more important
+         * @return The log level
+         */
+        [[nodiscard]]
+        static constexpr LogLevel with_borrowed_tag(std::string_view tag, unsigned int severity) {
+            return { BorrowedTag {}, tag, severity };
+        }
+
         [[nodiscard]]
-        const std::string& get_tag() {
+        constexpr std::string_view get_tag() const {
             return tag;
         }
+
+        [[nodiscard]]
+        constexpr unsigned int get_severity() const {
+            return severity;
+        }
+
+        /**
+         * Tells whether the messages of this level are compiled in, i.e.
+         * whether its severity is not below OOP_LOG_MIN_LEVEL.
+         *
+         * @return True if the messages of this level may be logged
+         */
+        [[nodiscard]]
+        constexpr bool is_compiled_in() const {
+#if OOP_LOG_MIN_LEVEL > 0
+            return severity >= OOP_LOG_MIN_LEVEL;
+#else
+            return true;
+#endif
+        }
     };
 
-    RegisterLogLevel(INFO);
-    RegisterLogLevel(WARNING);
-    RegisterLogLevel(ERROR);
+    RegisterLogLevel(TRACE, OOP_LOG_LEVEL_TRACE);
+    RegisterLogLevel(DEBUG, OOP_LOG_LEVEL_DEBUG);
+    RegisterLogLevel(INFO, OOP_LOG_LEVEL_INFO);
+    RegisterLogLevel(WARNING, OOP_LOG_LEVEL_WARNING);
+    RegisterLogLevel(ERROR, OOP_LOG_LEVEL_ERROR);
+
+    /**
+     * Returns a small number of the calling thread. Threads are numbered
+     * from 1 in the order they ask for their numbers, which makes the numbers
+     * more readable in logs than std::thread::id.
+     *
+     * @return The thread number
+     */
+    unsigned int get_thread_number();
+
+    /**
+     * Renders a custom pattern of a message format, appending the result to the buffer.
+     */
+    using PatternRenderer = std::function<void(std::string& buffer, const std::string& message, const LogLevel& level, std::chrono::system_clock::time_point timestamp)>;
 
     class MessageFormatter {
-        const std::string TIME_REPLACING_TAG = "%time";
-        const std::string LEVEL_REPLACING_TAG = "%level";
-        const std::string MESSAGE_REPLACING_TAG = "%message";
+        static constexpr std::string_view PATTERN_PREFIX = "%";
+        static constexpr std::string_view TIME_REPLACING_TAG = "time";
+        static constexpr std::string_view MILLISECONDS_REPLACING_TAG = "ms";
+        static constexpr std::string_view LEVEL_REPLACING_TAG = "level";
+        static constexpr std::string_view MESSAGE_REPLACING_TAG = "message";
+        static constexpr std::string_view THREAD_REPLACING_TAG = "thread";
+
+        enum class TokenKind {
+            LITERAL,
+            TIME,
+            MILLISECONDS,
+            LEVEL,
+            MESSAGE,
+            THREAD,
+            CUSTOM
+        };
+
+        struct Token {
+            TokenKind kind;
+            std::string literal;
+            PatternRenderer renderer;
+        };
+
         std::string message_format;
+        std::vector<Token> tokens;
+
+        static std::vector<std::pair<std::string, PatternRenderer>>& get_custom_patterns();
+
+        static std::mutex& get_custom_patterns_mutex();
+
+        /**
+         * Appends the time of the timestamp as HH:MM:SS. The local time is
+         * computed once per second per thread, other calls reuse it.
+         *
+         * @param buffer The buffer
+         * @param timestamp The timestamp
+         */
+        static void append_time(std::string& buffer, std::chrono::system_clock::time_point timestamp);
     public:
         /**
-         * Creates a new message formatter with passed format
+         * Creates a new message formatter with passed format. The format is parsed
+         * once here, so formatting only appends the parts to a buffer.
+         * Unknown patterns are kept as they are.
          *
-         * @see TIME_REPLACING_TAG, LEVEL_REPLACING_TAG, MESSAGE_REPLACING_TAG
+         * @see TIME_REPLACING_TAG, MILLISECONDS_REPLACING_TAG, LEVEL_REPLACING_TAG, MESSAGE_REPLACING_TAG, THREAD_REPLACING_TAG, register_pattern()
          * @param message_format
          */
         explicit MessageFormatter(std::string message_format);
 
+        /**
+         * Registers a custom pattern, e.g. '%file'. Only formatters
+         * created after the registration recognize it.
+         *
+         * @throws std::invalid_argument When the pattern name is empty
+         * @param name The pattern name without the percent sign
+         * @param renderer The function appending the pattern value to the buffer
+         */
+        static void register_pattern(const std::string& name, PatternRenderer renderer);
+
         /**
          * Formats the message.
          *
@@ -67,7 +220,33 @@ namespace PROJECT_NAME {
          * @param level The level of logging
          * @return The formatted message
          */
-        std::string format(const std::string& message, LogLevel& level) const;
+        [[nodiscard]]
+        std::string format(const std::string& message, const LogLevel& level) const;
+
+        /**
+         * Formats the message logged at the passed moment.
+         *
+         * @param message Message that should be formatted
+         * @param level The level of logging
+         * @param timestamp The moment the message was logged at
+         * @return The formatted message
+         */
+        [[nodiscard]]
+        std::string format(const std::string& message, const LogLevel& level, std::chrono::system_clock::time_point timestamp) const;
+
+        /**
+         * Formats the message appending it to the buffer. Nothing is allocated
+         * once the buffer is large enough, so reuse the same buffer for many messages.
+         *
+         * @param buffer The buffer the formatted message is appended to
+         * @param message Message that should be formatted
+         * @param level The level of logging
+         * @param timestamp The moment the message was logged at
+         */
+        void format_to(std::string& buffer, const std::string& message, const LogLevel& level, std::chrono::system_clock::time_point timestamp) const;
+
+        [[nodiscard]]
+        const std::string& get_message_format() const;
     };
 
     [[maybe_unused]]
@@ -76,8 +255,20 @@ namespace PROJECT_NAME {
                            MESSAGE_AND_LOG_LEVEL_FORMATTER("[%level]: %message");
 
     class AbstractLogger {
+        std::atomic<unsigned int> minimal_severity = OOP_LOG_LEVEL_TRACE;
+        std::unique_ptr<LoggerMetrics> metrics;
+        std::atomic<LoggerMetrics*> active_metrics = nullptr;
     protected:
         const MessageFormatter formatter;
+
+        /**
+         * Returns the metrics if they are enabled.
+         * @return The metrics or nullptr
+         */
+        [[nodiscard]]
+        LoggerMetrics* get_active_metrics() const {
+            return active_metrics.load(std::memory_order_acquire);
+        }
     public:
         /**
          * Initializes a base of loggers.
@@ -86,13 +277,93 @@ namespace PROJECT_NAME {
          */
         AbstractLogger(MessageFormatter formatter = DEFAULT_FORMATTER);
 
+        virtual ~AbstractLogger() = default;
+
         /**
-         * Logs the message.
+         * Logs the message. By default, it formats the message and writes it.
          *
          * @param message The message
          * @param level The log level
          */
-        virtual void log(const std::string& message, LogLevel level = INFO) = 0;
+        virtual void log(const std::string& message, LogLevel level = INFO);
+
+        /**
+         * Logs the message built by the function. The function is not called
+         * if the level is disabled, so disabled messages cost nothing to build.
+         *
+         * @param level The log level
+         * @param build_message The function returning the message
+         */
+        template<typename MessageBuilder> requires std::is_invocable_r_v<std::string, MessageBuilder>
+        void log(LogLevel level, MessageBuilder&& build_message) {
+            if(is_enabled(level))
+                log(std::forward<MessageBuilder>(build_message)(), level);
+        }
+
+        /**
+         * Sets the minimal level of the messages this logger logs. Messages
+         * with lower levels are discarded before they are formatted.
+         *
+         * @param level The minimal log level
+         */
+        void set_level(LogLevel level);
+
+        /**
+         * Tells whether the messages of the level are logged. This is a single relaxed
+         * atomic load, so check it before building an expensive message.
+         *
+         * @param level The log level
+         * @return True if the messages of the level are logged
+         */
+        [[nodiscard]]
+        bool is_enabled(LogLevel level) const {
+            return level.is_compiled_in() && level.get_severity() >= minimal_severity.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Writes an already formatted message to where the logger logs to.
+         *
+         * @param formatted_message The formatted message, ending with a line break
+         */
+        virtual void write(const std::string& formatted_message) = 0;
+
+        /**
+         * Makes everything written so far reach its destination.
+         */
+        virtual void flush();
+
+        /**
+         * Starts collecting metrics: counts of records and bytes, formatting and
+         * writing latencies. Metrics are not collected by default, so they cost nothing.
+         * Enabling them again continues the previous counts.
+         */
+        void enable_metrics();
+
+        /**
+         * Stops collecting metrics, keeping the collected ones.
+         */
+        void disable_metrics();
+
+        /**
+         * Takes a snapshot of the metrics. It is empty if the metrics were never enabled.
+         * @return The metrics snapshot
+         */
+        [[nodiscard]]
+        virtual LoggerMetricsSnapshot snapshot() const;
+
+        /**
+         * Logs a trace message. This is an equivalent of log(message, TRACE).
+         *
+         * @param message The message
+         */
+        virtual void trace(const std::string& message);
+
+        /**
+         * Logs a debug message. This is an equivalent of log(message, DEBUG).
+         *
+         * @param message The message
+         */
+        virtual void debug(const std::string& message);
 
         /**
          * Logs an error. This is an equivalent of log(message, INFO).
@@ -126,12 +397,16 @@ namespace PROJECT_NAME {
         explicit ConsoleLogger(MessageFormatter formatter = DEFAULT_FORMATTER);
 
         /**
-         * Logs a message to a console.
+         * Writes a formatted message to a console.
          *
-         * @param message The message
-         * @param level The log level
+         * @param formatted_message The formatted message
+         */
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Flushes the console output.
          */
-        void log(const std::string &message, LogLevel level = INFO) override;
+        void flush() override;
     };
 
     class FileLogger : public AbstractLogger {
@@ -146,15 +421,19 @@ namespace PROJECT_NAME {
         explicit FileLogger(const std::string& logger_filename, MessageFormatter formatter = DEFAULT_FORMATTER);
 
         /**
-         * Logs message to a file.
+         * Writes a formatted message to a file.
          *
-         * @param message The message
-         * @param level The log level
+         * @param formatted_message The formatted message
          */
-        void log(const std::string &message, LogLevel level = INFO) override;
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Flushes the file output stream.
+         */
+        void flush() override;
     };
 
-    class DoubleLogger : AbstractLogger {
+    class DoubleLogger : public AbstractLogger {
         std::unique_ptr<FileLogger> file_logger = nullptr;
         std::unique_ptr<ConsoleLogger> console_logger = nullptr;
     public:
@@ -167,12 +446,16 @@ namespace PROJECT_NAME {
         explicit DoubleLogger(const MessageFormatter& formatter = DEFAULT_FORMATTER, const std::string& logger_filename = "");
 
         /**
-         * Logs to the file and to the console both.
+         * Writes a formatted message to the file and to the console both.
          *
-         * @param message The message
-         * @param level The log level
+         * @param formatted_message The formatted message
+         */
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Flushes the file and the console both.
          */
-        void log(const std::string &message, LogLevel level = INFO) override;
+        void flush() override;
     };
 
     class LoggerFactory final {
@@ -0,0 +1,64 @@
+#include <logger_metrics.h++>
+#include <utils/json.h++>
+#include <sstream>
+
+namespace PROJECT_NAME {
+    double LoggerMetricsSnapshot::get_records_per_second() const {
+        return uptime_seconds > 0 ? static_cast<double>(records_count) / uptime_seconds : 0;
+    }
+
+    std::string LoggerMetricsSnapshot::to_json() const {
+        std::stringstream json;
+        json << "{ \"uptime_seconds\": " << uptime_seconds
+             << ", \"records\": " << records_count
+             << ", \"records_per_second\": " << get_records_per_second()
+             << ", \"bytes\": " << bytes_count
+             << ", \"output_calls\": " << output_calls_count
+             << ", \"output_bytes\": " << output_bytes_count
+             << ", \"queue_size\": " << queue_size
+             << ", \"dropped\": " << dropped_count
+             << ", \"caller\": { ";
+        write_latencies_json(json, caller_latencies);
+        json << " }, \"formatting\": { ";
+        write_latencies_json(json, formatting_latencies);
+        json << " }, \"writing\": { ";
+        write_latencies_json(json, writing_latencies);
+        json << " } }";
+
+        return json.str();
+    }
+
+    void LoggerMetrics::record(uint64_t bytes, uint64_t formatting_time, uint64_t writing_time) {
+        records_count.fetch_add(1, std::memory_order_relaxed);
+        bytes_count.fetch_add(bytes, std::memory_order_relaxed);
+
+        std::lock_guard lock { latencies_mutex };
+        formatting_latencies.record(formatting_time);
+        writing_latencies.record(writing_time);
+    }
+
+    void LoggerMetrics::record_output(uint64_t bytes) {
+        output_calls_count.fetch_add(1, std::memory_order_relaxed);
+        output_bytes_count.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void LoggerMetrics::record_caller(uint64_t caller_time) {
+        std::lock_guard lock { latencies_mutex };
+        caller_latencies.record(caller_time);
+    }
+
+    LoggerMetricsSnapshot LoggerMetrics::snapshot() const {
+        LoggerMetricsSnapshot snapshot;
+        snapshot.uptime_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - enabled_at).count();
+        snapshot.records_count = records_count.load(std::memory_order_relaxed);
+        snapshot.bytes_count = bytes_count.load(std::memory_order_relaxed);
+        snapshot.output_calls_count = output_calls_count.load(std::memory_order_relaxed);
+        snapshot.output_bytes_count = output_bytes_count.load(std::memory_order_relaxed);
+
+        std::lock_guard lock { latencies_mutex };
+        snapshot.caller_latencies = caller_latencies;
+        snapshot.formatting_latencies = formatting_latencies;
+        snapshot.writing_latencies = writing_latencies;
+        return snapshot;
+    }
+}
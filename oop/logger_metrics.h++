@@ -0,0 +1,82 @@
+/*
+ * -----------------------------------------------
+ * Logger Metrics
+ * -----------------------------------------------
+ * Self-instrumentation of loggers: how many records
+ * and bytes they have logged, how long callers spent
+ * in log(), how long formatting and writing took, and
+ * how many bytes reached the output. Snapshots of the metrics can be taken at
+ * any moment from any thread.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <utils/latency_histogram.h++>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace PROJECT_NAME {
+    struct LoggerMetricsSnapshot {
+        double uptime_seconds = 0;
+        uint64_t records_count = 0;
+        uint64_t bytes_count = 0;
+        uint64_t output_calls_count = 0;
+        uint64_t output_bytes_count = 0;
+        uint64_t queue_size = 0;
+        uint64_t dropped_count = 0;
+        LatencyHistogram caller_latencies;
+        LatencyHistogram formatting_latencies;
+        LatencyHistogram writing_latencies;
+
+        /**
+         * Returns an average count of records logged per second since the metrics were enabled.
+         * @return The count of records per second
+         */
+        [[nodiscard]]
+        double get_records_per_second() const;
+
+        /**
+         * Returns the snapshot as a single-line JSON object. Latencies are in nanoseconds.
+         * @return The JSON object
+         */
+        [[nodiscard]]
+        std::string to_json() const;
+    };
+
+    class LoggerMetrics {
+        std::chrono::steady_clock::time_point enabled_at = std::chrono::steady_clock::now();
+        std::atomic<uint64_t> records_count = 0, bytes_count = 0, output_calls_count = 0, output_bytes_count = 0;
+        LatencyHistogram caller_latencies, formatting_latencies, writing_latencies;
+        mutable std::mutex latencies_mutex;
+    public:
+        /**
+         * Records a logged record.
+         *
+         * @param bytes A size of the formatted record
+         * @param formatting_time Nanoseconds spent formatting the record
+         * @param writing_time Nanoseconds spent writing the record
+         */
+        void record(uint64_t bytes, uint64_t formatting_time, uint64_t writing_time);
+
+        /**
+         * Records a write to the final output, e.g. a system call writing a buffer to a file.
+         * @param bytes A count of bytes written
+         */
+        void record_output(uint64_t bytes);
+
+        /**
+         * Records a time a caller spent in log(), e.g. waiting for a free slot in a queue.
+         * @param caller_time Nanoseconds spent by the caller
+         */
+        void record_caller(uint64_t caller_time);
+
+        [[nodiscard]]
+        LoggerMetricsSnapshot snapshot() const;
+    };
+}
@@ -0,0 +1,34 @@
+#include <logger_metrics_dumper.h++>
+
+namespace PROJECT_NAME {
+    LoggerMetricsDumper::LoggerMetricsDumper(const AbstractLogger& logger, const std::string& dump_filename, std::chrono::milliseconds dumping_interval)
+        : logger(logger), dump_output_stream(dump_filename, std::ios::app), dumping_interval(dumping_interval) {
+        if(!dump_output_stream.is_open())
+            throw std::runtime_error("Cannot open file '"s + dump_filename + "' for dumping logger metrics");
+
+        dumping_thread = std::thread(&LoggerMetricsDumper::work, this);
+    }
+
+    LoggerMetricsDumper::~LoggerMetricsDumper() {
+        {
+            std::lock_guard lock { dumping_mutex };
+            stopping = true;
+        }
+
+        stopping_requested.notify_one();
+        dumping_thread.join();
+        dump();
+    }
+
+    void LoggerMetricsDumper::dump() {
+        dump_output_stream << logger.snapshot().to_json() << std::endl;
+    }
+
+    void LoggerMetricsDumper::work() {
+        std::unique_lock lock { dumping_mutex };
+
+        while(!stopping_requested.wait_for(lock, dumping_interval, [&] { return stopping; })) {
+            dump();
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * -----------------------------------------------
+ * Logger Metrics Dumper
+ * -----------------------------------------------
+ * Periodically appends snapshots of a logger
+ * metrics to a file, one JSON object per line,
+ * so the logging load can be observed over time.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "logger.h++"
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace PROJECT_NAME {
+    class LoggerMetricsDumper {
+        const AbstractLogger& logger;
+        std::ofstream dump_output_stream;
+        std::chrono::milliseconds dumping_interval;
+        std::mutex dumping_mutex;
+        std::condition_variable stopping_requested;
+        bool stopping = false;
+        std::thread dumping_thread;
+
+        void dump();
+
+        void work();
+    public:
+        /**
+         * Starts dumping the metrics of the logger. The metrics should be enabled
+         * in the logger, and the logger should outlive the dumper.
+         *
+         * @throws std::runtime_error When the file cannot be opened
+         * @param logger The logger
+         * @param dump_filename The file the snapshots are appended to
+         * @param dumping_interval An interval between snapshots
+         */
+        LoggerMetricsDumper(const AbstractLogger& logger, const std::string& dump_filename, std::chrono::milliseconds dumping_interval = std::chrono::seconds(10));
+
+        LoggerMetricsDumper(const LoggerMetricsDumper&) = delete;
+        LoggerMetricsDumper& operator=(const LoggerMetricsDumper&) = delete;
+
+        /**
+         * Stops dumping after a final snapshot.
+         */
+        ~LoggerMetricsDumper();
+    };
+}
@@ -0,0 +1,142 @@
+#include <mapped_file_logger.h++>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace PROJECT_NAME {
+    MappedFileLogger::MappedFileLogger(std::string logger_filename, size_t segment_size, MessageFormatter formatter)
+        : AbstractLogger(std::move(formatter)), logger_filename(std::move(logger_filename)) {
+        auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        this->segment_size = (std::max<size_t>(segment_size, 1) + page_size - 1) / page_size * page_size;
+
+        map_segment();
+    }
+
+    MappedFileLogger::~MappedFileLogger() {
+        std::unique_lock lock { mapping_mutex };
+
+        if(int error = unmap_segment(); error != 0)
+            std::cerr << "Log file '" << get_segment_filename() << "' cannot be truncated: " << std::strerror(error) << std::endl;
+    }
+
+    std::string MappedFileLogger::get_segment_filename() const {
+        return segment_number == 0 ? logger_filename : logger_filename + "." + std::to_string(segment_number);
+    }
+
+    std::atomic_ref<uint64_t> MappedFileLogger::get_committed_offset() const {
+        return std::atomic_ref<uint64_t>(*reinterpret_cast<uint64_t*>(mapping + COMMITTED_OFFSET_POSITION));
+    }
+
+    void MappedFileLogger::map_segment() {
+        auto segment_filename = get_segment_filename();
+
+        file_descriptor = ::open(segment_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if(file_descriptor == -1)
+            throw std::runtime_error("Log file '"s + segment_filename + "' cannot be opened: " + std::strerror(errno));
+
+        if(int error = ::posix_fallocate(file_descriptor, 0, static_cast<off_t>(segment_size)); error != 0) {
+            ::close(file_descriptor);
+            throw std::runtime_error("Log file '"s + segment_filename + "' cannot be preallocated: " + std::strerror(error));
+        }
+
+        void* segment_mapping = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+        if(segment_mapping == MAP_FAILED) {
+            ::close(file_descriptor);
+            throw std::runtime_error("Log file '"s + segment_filename + "' cannot be mapped: " + std::strerror(errno));
+        }
+
+        mapping = static_cast<char*>(segment_mapping);
+        std::memcpy(mapping, HEADER_MAGIC, sizeof(HEADER_MAGIC));
+        get_committed_offset().store(HEADER_SIZE, std::memory_order_release);
+        reserved_offset = HEADER_SIZE;
+        segment_generation++;
+    }
+
+    int MappedFileLogger::unmap_segment() {
+        auto committed_offset = get_committed_offset().load(std::memory_order_acquire);
+        ::munmap(mapping, segment_size);
+
+        int error = ::ftruncate(file_descriptor, static_cast<off_t>(committed_offset)) == -1 ? errno : 0;
+        ::close(file_descriptor);
+
+        mapping = nullptr;
+        file_descriptor = -1;
+        return error;
+    }
+
+    void MappedFileLogger::write(const std::string& formatted_message) {
+        if(formatted_message.size() > segment_size - HEADER_SIZE)
+            throw std::invalid_argument("Message of "s + std::to_string(formatted_message.size()) + " bytes does not fit into a log segment of " + std::to_string(segment_size) + " bytes");
+
+        while(true) {
+            unsigned long long seen_generation;
+            {
+                std::shared_lock lock { mapping_mutex };
+                seen_generation = segment_generation;
+
+                auto record_offset = reserved_offset.fetch_add(formatted_message.size(), std::memory_order_relaxed);
+                auto record_end = record_offset + formatted_message.size();
+
+                if(record_end <= segment_size) {
+                    std::memcpy(mapping + record_offset, formatted_message.data(), formatted_message.size());
+
+                    auto committed_offset = get_committed_offset();
+                    while(committed_offset.load(std::memory_order_acquire) != record_offset)
+                        std::this_thread::yield();
+
+                    committed_offset.store(record_end, std::memory_order_release);
+                    return;
+                }
+            }
+
+            std::unique_lock lock { mapping_mutex };
+            if(segment_generation != seen_generation)
+                continue;
+
+            auto full_segment_filename = get_segment_filename();
+            int error = unmap_segment();
+            segment_number++;
+            map_segment();
+
+            if(error != 0)
+                throw std::runtime_error("Log file '"s + full_segment_filename + "' cannot be truncated: " + std::strerror(error));
+        }
+    }
+
+    void MappedFileLogger::flush() {
+        std::shared_lock lock { mapping_mutex };
+        ::msync(mapping, segment_size, MS_ASYNC);
+    }
+
+    void MappedFileLogger::sync() {
+        std::shared_lock lock { mapping_mutex };
+        ::msync(mapping, segment_size, MS_SYNC);
+    }
+
+    std::string MappedFileLogger::read_segment(const std::string& segment_filename) {
+        std::ifstream segment_file(segment_filename, std::ios::binary);
+        if(!segment_file.is_open())
+            throw std::runtime_error("Log file '"s + segment_filename + "' cannot be opened");
+
+        char header[HEADER_SIZE];
+        if(!segment_file.read(header, HEADER_SIZE) || std::memcmp(header, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0)
+            throw std::runtime_error("File '"s + segment_filename + "' is not a mapped log segment");
+
+        uint64_t committed_offset;
+        std::memcpy(&committed_offset, header + COMMITTED_OFFSET_POSITION, sizeof(committed_offset));
+        if(committed_offset < HEADER_SIZE)
+            throw std::runtime_error("Mapped log segment '"s + segment_filename + "' has a broken header");
+
+        std::string records(committed_offset - HEADER_SIZE, '\0');
+        segment_file.read(records.data(), static_cast<std::streamsize>(records.size()));
+        records.resize(static_cast<size_t>(segment_file.gcount()));
+        return records;
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * -----------------------------------------------
+ * Mapped File Logger
+ * -----------------------------------------------
+ * The lowest-latency file sink: the log file is
+ * preallocated and mapped to memory, so a record
+ * is appended with an atomic offset bump and a
+ * memcpy, without a system call. When a segment is
+ * full, the logger rolls over to the next file.
+ * Every segment starts with a header holding the
+ * end of the records written completely, so the
+ * valid records are found even after a crash.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "logger.h++"
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+namespace PROJECT_NAME {
+    class MappedFileLogger : public AbstractLogger {
+        static constexpr char HEADER_MAGIC[8] = { 'O', 'O', 'P', 'M', 'L', 'O', 'G', '1' };
+        static constexpr size_t COMMITTED_OFFSET_POSITION = sizeof(HEADER_MAGIC);
+        static constexpr size_t HEADER_SIZE = COMMITTED_OFFSET_POSITION + sizeof(uint64_t);
+
+        std::string logger_filename;
+        size_t segment_size;
+        unsigned int segment_number = 0;
+        int file_descriptor = -1;
+        char* mapping = nullptr;
+        std::atomic<size_t> reserved_offset = 0;
+        unsigned long long segment_generation = 0;
+        std::shared_mutex mapping_mutex;
+
+        [[nodiscard]]
+        std::string get_segment_filename() const;
+
+        /**
+         * Returns the committed offset stored in the header of the mapped segment.
+         * Records before it are written completely, and there are no gaps between them.
+         */
+        [[nodiscard]]
+        std::atomic_ref<uint64_t> get_committed_offset() const;
+
+        /**
+         * Creates the current segment file, preallocates and maps it.
+         * @throws std::runtime_error When the file cannot be created or mapped
+         */
+        void map_segment();
+
+        /**
+         * Unmaps the current segment and truncates its file to the committed offset.
+         * The segment is closed even if it cannot be truncated, as its header still
+         * tells where the records end.
+         *
+         * @return 0, or the error number if the file cannot be truncated
+         */
+        [[nodiscard]]
+        int unmap_segment();
+    public:
+        /**
+         * Creates a new mapped file logger, replacing the file. Segments are named
+         * as the file, then with '.1', '.2' and so on, in the chronological order.
+         * The logger is thread-safe.
+         *
+         * @throws std::runtime_error When the file cannot be created or mapped
+         * @param logger_filename The file where logs will be written to
+         * @param segment_size A size of a segment file, rounded up to the page size
+         * @param formatter The logger message formatter
+         */
+        explicit MappedFileLogger(std::string logger_filename, size_t segment_size = 64 << 20, MessageFormatter formatter = DEFAULT_FORMATTER);
+
+        MappedFileLogger(const MappedFileLogger&) = delete;
+        MappedFileLogger& operator=(const MappedFileLogger&) = delete;
+
+        /**
+         * Unmaps the last segment and truncates its file to the committed offset.
+         */
+        ~MappedFileLogger() override;
+
+        /**
+         * Appends a formatted message. Records written concurrently are copied
+         * in parallel, then committed in the order of their offsets, so a record
+         * waits only for the copying of the records before it. Only rolling over
+         * to the next segment blocks the writers.
+         *
+         * @throws std::invalid_argument When the message does not fit into a segment
+         * @throws std::runtime_error When the next segment cannot be created
+         * @param formatted_message The formatted message
+         */
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Starts writing the mapped pages back to the file without waiting.
+         */
+        void flush() override;
+
+        /**
+         * Writes the mapped pages back to the file and waits until they are written.
+         */
+        void sync();
+
+        /**
+         * Reads the committed records of a segment file, skipping the header and
+         * anything written after the committed offset, e.g. by a crashed process.
+         *
+         * @throws std::runtime_error When the file cannot be read or is not a log segment
+         * @param segment_filename The segment file
+         * @return The committed records
+         */
+        [[nodiscard]]
+        static std::string read_segment(const std::string& segment_filename);
+    };
+}
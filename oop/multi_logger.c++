@@ -0,0 +1,46 @@
+#include <multi_logger.h++>
+
+namespace PROJECT_NAME {
+    MultiLogger::MultiLogger(MessageFormatter formatter) : AbstractLogger(std::move(formatter)) {
+        //
+    }
+
+    size_t MultiLogger::add_sink(std::unique_ptr<AbstractLogger> sink, size_t capacity, OverflowPolicy overflow_policy) {
+        sinks.push_back(std::make_unique<AsyncLogger>(std::move(sink), capacity, overflow_policy, formatter));
+        return sinks.size() - 1;
+    }
+
+    void MultiLogger::write(const std::string& formatted_message) {
+        for(auto& sink : sinks) {
+            sink->write(formatted_message);
+        }
+    }
+
+    void MultiLogger::flush() {
+        for(auto& sink : sinks) {
+            sink->flush();
+        }
+    }
+
+    LoggerMetricsSnapshot MultiLogger::snapshot() const {
+        auto snapshot = AbstractLogger::snapshot();
+
+        for(const auto& sink : sinks) {
+            snapshot.queue_size += sink->get_queue_size();
+            snapshot.dropped_count += sink->get_dropped_count();
+        }
+
+        return snapshot;
+    }
+
+    size_t MultiLogger::get_sink_count() const {
+        return sinks.size();
+    }
+
+    const AsyncLogger& MultiLogger::get_sink(size_t index) const {
+        if(index >= sinks.size())
+            throw std::out_of_range("Multi logger has "s + std::to_string(sinks.size()) + " sinks, so there is no sink #" + std::to_string(index));
+
+        return *sinks[index];
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * -----------------------------------------------
+ * Multi Logger
+ * -----------------------------------------------
+ * Fans every message out to any number of sinks.
+ * The message is formatted once, and every sink
+ * gets its own buffer and thread, so a slow sink
+ * never holds the others back.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "logger.h++"
+#include "async_logger.h++"
+#include <memory>
+#include <vector>
+
+namespace PROJECT_NAME {
+    class MultiLogger : public AbstractLogger {
+        std::vector<std::unique_ptr<AsyncLogger>> sinks;
+    public:
+        /**
+         * Creates a new multi logger without sinks.
+         *
+         * @param formatter The logger message formatter, sink formatters are not used
+         */
+        explicit MultiLogger(MessageFormatter formatter = DEFAULT_FORMATTER);
+
+        /**
+         * Adds a sink with its own buffer and thread. Add all the sinks before logging.
+         *
+         * @throws std::invalid_argument When the sink is missing or the capacity is not a power of two
+         * @param sink The logger the messages will be written to
+         * @param capacity A maximal count of messages buffered for this sink
+         * @param overflow_policy What to do when this sink buffer is full
+         * @return The sink index
+         */
+        size_t add_sink(std::unique_ptr<AbstractLogger> sink, size_t capacity = 8192, OverflowPolicy overflow_policy = OverflowPolicy::BLOCK);
+
+        /**
+         * Hands the already formatted message to the asynchronous logger of every sink.
+         * The message is formatted once by log(), the sinks only write it.
+         *
+         * @param formatted_message The formatted message
+         */
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Waits until every sink writes everything written so far.
+         */
+        void flush() override;
+
+        /**
+         * Takes a snapshot of the metrics. The queue size and the count
+         * of dropped records are summed over all the sinks.
+         *
+         * @return The metrics snapshot
+         */
+        [[nodiscard]]
+        LoggerMetricsSnapshot snapshot() const override;
+
+        [[nodiscard]]
+        size_t get_sink_count() const;
+
+        /**
+         * Returns the asynchronous logger of a sink. Its dropped count, queue size
+         * and write latencies tell which sink slows logging down.
+         *
+         * @throws std::out_of_range When there is no sink with the index
+         * @param index The sink index
+         * @return The asynchronous logger of the sink
+         */
+        [[nodiscard]]
+        const AsyncLogger& get_sink(size_t index) const;
+    };
+}
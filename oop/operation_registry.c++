@@ -0,0 +1,115 @@
+#include <operation_registry.h++>
+#include <bit>
+#include <stdexcept>
+
+namespace PROJECT_NAME {
+    static constexpr size_t MINIMAL_HASH_SLOT_COUNT = 8;
+    static constexpr int HASH_SEED_ATTEMPTS_PER_SIZE = 64;
+
+    uint64_t OperationRegistry::hash(std::string_view name, uint64_t seed) {
+        uint64_t hash = 0xcbf29ce484222325ULL ^ seed;
+
+        for(const auto& character : name) {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= 0x100000001b3ULL;
+        }
+
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    OperationRegistry::OperationId OperationRegistry::find_linearly(std::string_view name) const {
+        for(OperationId id = 0; id < operation_names.size(); id++) {
+            if(operation_names[id] == name)
+                return id;
+        }
+
+        return UNKNOWN_OPERATION;
+    }
+
+    OperationRegistry::OperationId OperationRegistry::register_operation(const std::string& name, Operation operation) {
+        if(operation == nullptr)
+            throw std::invalid_argument("Operation '"s + name + "' cannot be registered without an implementation");
+
+        finalized = false;
+
+        if(auto existing_id = find_linearly(name); existing_id != UNKNOWN_OPERATION) {
+            operations[existing_id] = operation;
+
+            if(auto inverse_id = inverse_operations[existing_id]; inverse_id != UNKNOWN_OPERATION) {
+                inverse_operations[inverse_id] = UNKNOWN_OPERATION;
+                inverse_operations[existing_id] = UNKNOWN_OPERATION;
+            }
+
+            return existing_id;
+        }
+
+        operation_names.push_back(name);
+        operations.push_back(operation);
+        inverse_operations.push_back(UNKNOWN_OPERATION);
+        return static_cast<OperationId>(operations.size() - 1);
+    }
+
+    void OperationRegistry::set_inverse(OperationId id, OperationId inverse_id) {
+        if(id >= operations.size() || inverse_id >= operations.size())
+            throw std::out_of_range("Cannot make operations "s + std::to_string(id) + " and " + std::to_string(inverse_id) + " inverse, because some of them are not registered");
+
+        inverse_operations[id] = inverse_id;
+        inverse_operations[inverse_id] = id;
+    }
+
+    OperationRegistry::OperationId OperationRegistry::get_inverse(OperationId id) const {
+        return id < inverse_operations.size() ? inverse_operations[id] : UNKNOWN_OPERATION;
+    }
+
+    void OperationRegistry::finalize() {
+        for(size_t slot_count = std::bit_ceil(std::max(MINIMAL_HASH_SLOT_COUNT, operation_names.size() * 2)); ; slot_count *= 2) {
+            for(uint64_t seed = 0; seed < HASH_SEED_ATTEMPTS_PER_SIZE; seed++) {
+                std::vector<OperationId> slots(slot_count, UNKNOWN_OPERATION);
+                bool collided = false;
+
+                for(OperationId id = 0; id < operation_names.size() && !collided; id++) {
+                    auto& slot = slots[hash(operation_names[id], seed) & (slot_count - 1)];
+                    collided = slot != UNKNOWN_OPERATION;
+                    slot = id;
+                }
+
+                if(!collided) {
+                    hash_slots = std::move(slots);
+                    hash_seed = seed;
+                    finalized = true;
+                    return;
+                }
+            }
+        }
+    }
+
+    bool OperationRegistry::is_finalized() const {
+        return finalized;
+    }
+
+    OperationRegistry::OperationId OperationRegistry::find(std::string_view name) const {
+        if(!finalized)
+            return find_linearly(name);
+
+        auto id = hash_slots[hash(name, hash_seed) & (hash_slots.size() - 1)];
+        return id != UNKNOWN_OPERATION && operation_names[id] == name ? id : UNKNOWN_OPERATION;
+    }
+
+    const std::string& OperationRegistry::get_name(OperationId id) const {
+        if(id >= operation_names.size())
+            throw std::out_of_range("There is no operation with id "s + std::to_string(id));
+
+        return operation_names[id];
+    }
+
+    const std::vector<std::string>& OperationRegistry::get_names() const {
+        return operation_names;
+    }
+
+    size_t OperationRegistry::size() const {
+        return operations.size();
+    }
+}
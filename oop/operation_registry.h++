@@ -0,0 +1,111 @@
+/*
+ * -----------------------------------------------
+ * Operation Registry
+ * -----------------------------------------------
+ * Keeps the operations of the big integer command
+ * executor. Every operation gets a dense integer id
+ * at registration, so it can be dispatched through
+ * a flat array of function pointers. Names are
+ * looked up through a perfect hash, which is built
+ * once the registry is finalized.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "bigint.h++"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PROJECT_NAME {
+    class OperationRegistry {
+    public:
+        using Operation = void(*)(bigint& destination, const bigint& operand);
+        using OperationId = uint32_t;
+
+        static constexpr OperationId UNKNOWN_OPERATION = std::numeric_limits<OperationId>::max();
+    private:
+        std::vector<std::string> operation_names;
+        std::vector<Operation> operations;
+        std::vector<OperationId> inverse_operations;
+        std::vector<OperationId> hash_slots;
+        uint64_t hash_seed = 0;
+        bool finalized = false;
+
+        [[nodiscard]]
+        static uint64_t hash(std::string_view name, uint64_t seed);
+
+        [[nodiscard]]
+        OperationId find_linearly(std::string_view name) const;
+    public:
+        /**
+         * Registers a new operation or replaces the existing one with the same name.
+         * A replaced operation keeps its id. Registering invalidates the finalization.
+         *
+         * @param name The operation name, e.g. POW
+         * @param operation The operation, which applies an operand to the destination
+         * @return The operation id
+         */
+        OperationId register_operation(const std::string& name, Operation operation);
+
+        /**
+         * Marks two operations as inverse to each other, e.g. ADD and SUB, so that
+         * applying one after another with the same operand restores the value.
+         *
+         * @param id The operation id
+         * @param inverse_id The inverse operation id
+         */
+        void set_inverse(OperationId id, OperationId inverse_id);
+
+        /**
+         * Returns the id of the operation inverse to the passed one.
+         * @param id The operation id
+         * @return The inverse operation id, or UNKNOWN_OPERATION if the operation cannot be reverted
+         */
+        [[nodiscard]]
+        OperationId get_inverse(OperationId id) const;
+
+        /**
+         * Builds the perfect hash of operation names, making find() constant-time.
+         */
+        void finalize();
+
+        [[nodiscard]]
+        bool is_finalized() const;
+
+        /**
+         * Finds an operation id by its name. If the registry is not finalized,
+         * it falls back to a linear search.
+         *
+         * @param name The operation name
+         * @return The operation id, or UNKNOWN_OPERATION if there is no such operation
+         */
+        [[nodiscard]]
+        OperationId find(std::string_view name) const;
+
+        /**
+         * Applies the operation with the passed id.
+         *
+         * @param id The operation id, returned by find() or register_operation()
+         * @param destination The big integer the operation is applied to
+         * @param operand The operand
+         */
+        void invoke(OperationId id, bigint& destination, const bigint& operand) const {
+            operations[id](destination, operand);
+        }
+
+        [[nodiscard]]
+        const std::string& get_name(OperationId id) const;
+
+        [[nodiscard]]
+        const std::vector<std::string>& get_names() const;
+
+        [[nodiscard]]
+        size_t size() const;
+    };
+}
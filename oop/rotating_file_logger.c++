@@ -0,0 +1,215 @@
+#include <rotating_file_logger.h++>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace PROJECT_NAME {
+    RotatingFileLogger::RotatingFileLogger(std::string logger_filename, RotatingFileLoggerOptions options, MessageFormatter formatter)
+        : AbstractLogger(std::move(formatter)), logger_filename(std::move(logger_filename)), options(std::move(options)) {
+        if(this->options.buffer_size == 0)
+            throw std::invalid_argument("Rotating file logger buffer size cannot be zero");
+
+        if(this->options.fsync_policy == FsyncPolicy::EVERY_N_RECORDS && this->options.fsync_records_count == 0)
+            throw std::invalid_argument("Rotating file logger cannot synchronize every 0 records");
+
+        buffer.reserve(this->options.buffer_size);
+        open_file();
+    }
+
+    RotatingFileLogger::~RotatingFileLogger() {
+        try {
+            write_buffer();
+
+            if(options.fsync_policy != FsyncPolicy::NEVER)
+                synchronize();
+        } catch(const std::exception& exception) {
+            std::cerr << exception.what() << std::endl;
+        }
+
+        close_file();
+
+        if(compression_thread.joinable())
+            compression_thread.join();
+    }
+
+    void RotatingFileLogger::open_file() {
+        file_descriptor = ::open(logger_filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if(file_descriptor == -1)
+            throw std::runtime_error("Log file '"s + logger_filename + "' cannot be opened: " + std::strerror(errno));
+
+        struct stat file_status {};
+        file_size = ::fstat(file_descriptor, &file_status) == 0 ? file_status.st_size : 0;
+        file_opened_at = last_fsync_at = std::chrono::steady_clock::now();
+        records_since_fsync = 0;
+    }
+
+    void RotatingFileLogger::close_file() {
+        if(file_descriptor != -1) {
+            ::close(file_descriptor);
+            file_descriptor = -1;
+        }
+    }
+
+    void RotatingFileLogger::write_fully(std::string_view first, std::string_view second) {
+        iovec parts[2] = {
+            { const_cast<char*>(first.data()), first.size() },
+            { const_cast<char*>(second.data()), second.size() },
+        };
+
+        size_t first_part = 0, part_count = second.empty() ? 1 : 2;
+        while(first_part < part_count) {
+            ssize_t written_size = ::writev(file_descriptor, parts + first_part, static_cast<int>(part_count - first_part));
+
+            if(written_size == -1) {
+                if(errno == EINTR)
+                    continue;
+
+                throw std::runtime_error("Log file '"s + logger_filename + "' cannot be written: " + std::strerror(errno));
+            }
+
+            if(auto metrics = get_active_metrics())
+                metrics->record_output(written_size);
+
+            auto remaining_size = static_cast<size_t>(written_size);
+            while(first_part < part_count && remaining_size >= parts[first_part].iov_len) {
+                remaining_size -= parts[first_part].iov_len;
+                first_part++;
+            }
+
+            if(first_part < part_count) {
+                parts[first_part].iov_base = static_cast<char*>(parts[first_part].iov_base) + remaining_size;
+                parts[first_part].iov_len -= remaining_size;
+            }
+        }
+    }
+
+    void RotatingFileLogger::write_buffer() {
+        if(buffer.empty())
+            return;
+
+        write_fully(buffer);
+        buffer.clear();
+    }
+
+    void RotatingFileLogger::synchronize() {
+        if(::fdatasync(file_descriptor) == -1)
+            throw std::runtime_error("Log file '"s + logger_filename + "' cannot be synchronized: " + std::strerror(errno));
+
+        records_since_fsync = 0;
+        last_fsync_at = std::chrono::steady_clock::now();
+    }
+
+    std::string RotatingFileLogger::get_rotated_filename(unsigned int index) const {
+        return logger_filename + "." + std::to_string(index);
+    }
+
+    void RotatingFileLogger::rotate() {
+        write_buffer();
+
+        if(options.fsync_policy != FsyncPolicy::NEVER)
+            synchronize();
+
+        close_file();
+
+        if(compression_thread.joinable())
+            compression_thread.join();
+
+        std::error_code error;
+        if(options.max_rotated_files == 0) {
+            std::filesystem::remove(logger_filename, error);
+        } else {
+            std::vector<std::string> extensions = { "" };
+            if(options.compressor)
+                extensions.push_back(options.compressed_extension);
+
+            for(unsigned int index = options.max_rotated_files; index >= 1; index--) {
+                for(const auto& extension : extensions) {
+                    auto rotated_filename = get_rotated_filename(index) + extension;
+
+                    if(index == options.max_rotated_files)
+                        std::filesystem::remove(rotated_filename, error);
+                    else if(std::filesystem::exists(rotated_filename, error))
+                        std::filesystem::rename(rotated_filename, get_rotated_filename(index + 1) + extension, error);
+                }
+            }
+
+            std::filesystem::rename(logger_filename, get_rotated_filename(1), error);
+
+            if(options.compressor)
+                compression_thread = std::thread(options.compressor, get_rotated_filename(1));
+        }
+
+        open_file();
+    }
+
+    void RotatingFileLogger::write(const std::string& formatted_message) {
+        bool file_is_full = options.max_file_size != 0 && file_size != 0 && file_size + formatted_message.size() > options.max_file_size;
+        bool file_is_old = options.rotation_interval.count() != 0 && std::chrono::steady_clock::now() - file_opened_at >= options.rotation_interval;
+
+        if(file_is_full || file_is_old)
+            rotate();
+
+        if(buffer.size() + formatted_message.size() > options.buffer_size) {
+            if(formatted_message.size() >= options.buffer_size) {
+                write_fully(buffer, formatted_message);
+                buffer.clear();
+            } else {
+                write_buffer();
+                buffer.append(formatted_message);
+            }
+        } else {
+            buffer.append(formatted_message);
+        }
+
+        file_size += formatted_message.size();
+        records_since_fsync++;
+
+        bool synchronization_needed = false;
+        switch(options.fsync_policy) {
+            case FsyncPolicy::NEVER:
+                break;
+            case FsyncPolicy::EVERY_N_RECORDS:
+                synchronization_needed = records_since_fsync >= options.fsync_records_count;
+                break;
+            case FsyncPolicy::EVERY_INTERVAL:
+                synchronization_needed = std::chrono::steady_clock::now() - last_fsync_at >= options.fsync_interval;
+                break;
+        }
+
+        if(synchronization_needed) {
+            write_buffer();
+            synchronize();
+        }
+    }
+
+    void RotatingFileLogger::flush() {
+        write_buffer();
+    }
+
+    void RotatingFileLogger::gzip_compressor(const std::string& path) {
+        char* arguments[] = { const_cast<char*>("gzip"), const_cast<char*>("-f"), const_cast<char*>("--"), const_cast<char*>(path.c_str()), nullptr };
+
+        pid_t compressor_pid;
+        if(int error = ::posix_spawnp(&compressor_pid, "gzip", nullptr, nullptr, arguments, environ); error != 0) {
+            std::cerr << "Log file '" << path << "' cannot be compressed: " << std::strerror(error) << std::endl;
+            return;
+        }
+
+        int status;
+        while(::waitpid(compressor_pid, &status, 0) == -1) {
+            if(errno != EINTR) {
+                std::cerr << "Log file '" << path << "' compression cannot be awaited: " << std::strerror(errno) << std::endl;
+                return;
+            }
+        }
+
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            std::cerr << "Log file '" << path << "' cannot be compressed" << std::endl;
+    }
+}
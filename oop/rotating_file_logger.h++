@@ -0,0 +1,126 @@
+/*
+ * -----------------------------------------------
+ * Rotating File Logger
+ * -----------------------------------------------
+ * A file logger for long-running jobs. Messages
+ * are collected in a large buffer and written with
+ * a single system call, the file is rotated by size
+ * and age, old files can be compressed in the
+ * background, and the durability is configurable.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "logger.h++"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace PROJECT_NAME {
+    /**
+     * Tells when written logs are synchronized to the disk:
+     * NEVER leaves it to the operating system, EVERY_N_RECORDS
+     * synchronizes after a count of records, EVERY_INTERVAL
+     * synchronizes when a record is written after the interval passed.
+     */
+    enum class FsyncPolicy {
+        NEVER,
+        EVERY_N_RECORDS,
+        EVERY_INTERVAL
+    };
+
+    struct RotatingFileLoggerOptions {
+        size_t buffer_size = 1 << 20;
+        size_t max_file_size = 0;
+        std::chrono::seconds rotation_interval { 0 };
+        unsigned int max_rotated_files = 5;
+        std::function<void(const std::string& path)> compressor = nullptr;
+        std::string compressed_extension = ".gz";
+        FsyncPolicy fsync_policy = FsyncPolicy::NEVER;
+        unsigned int fsync_records_count = 1024;
+        std::chrono::milliseconds fsync_interval { 1000 };
+    };
+
+    class RotatingFileLogger : public AbstractLogger {
+        std::string logger_filename;
+        RotatingFileLoggerOptions options;
+        int file_descriptor = -1;
+        std::string buffer;
+        size_t file_size = 0;
+        unsigned int records_since_fsync = 0;
+        std::chrono::steady_clock::time_point file_opened_at, last_fsync_at;
+        std::thread compression_thread;
+
+        void open_file();
+
+        void close_file();
+
+        /**
+         * Writes the data to the file, repeating the call until everything is written.
+         *
+         * @throws std::runtime_error When the file cannot be written
+         * @param first The first part of the data
+         * @param second The second part of the data, may be empty
+         */
+        void write_fully(std::string_view first, std::string_view second = {});
+
+        void write_buffer();
+
+        void synchronize();
+
+        /**
+         * Closes the current file, shifts the rotated ones, dropping the oldest,
+         * and opens a new file. The file just closed is compressed in the background.
+         */
+        void rotate();
+
+        [[nodiscard]]
+        std::string get_rotated_filename(unsigned int index) const;
+    public:
+        /**
+         * Creates a new rotating file logger appending to the file.
+         * It is not thread-safe, wrap it into an AsyncLogger to log from many threads.
+         *
+         * @throws std::runtime_error When the file cannot be opened
+         * @throws std::invalid_argument When the options are inconsistent
+         * @param logger_filename The file where logs will be written to, rotated files get '.1', '.2' and so on
+         * @param options The buffering, rotation and synchronization options
+         * @param formatter The logger message formatter
+         */
+        explicit RotatingFileLogger(std::string logger_filename, RotatingFileLoggerOptions options = {}, MessageFormatter formatter = DEFAULT_FORMATTER);
+
+        RotatingFileLogger(const RotatingFileLogger&) = delete;
+        RotatingFileLogger& operator=(const RotatingFileLogger&) = delete;
+
+        /**
+         * Writes the buffer, synchronizes the file unless the policy is NEVER,
+         * and waits for the background compression.
+         */
+        ~RotatingFileLogger() override;
+
+        /**
+         * Appends a formatted message to the buffer, writing the buffer
+         * and rotating the file when needed.
+         *
+         * @param formatted_message The formatted message
+         */
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Writes the buffer to the file.
+         */
+        void flush() override;
+
+        /**
+         * Compresses the file with the gzip utility, replacing it with a '.gz' one.
+         * The utility is spawned directly, without a shell, and its failures are reported to std::cerr.
+         * @param path The file path
+         */
+        static void gzip_compressor(const std::string& path);
+    };
+}
@@ -2,7 +2,9 @@
  * -----------------------------------------------
  * Stack
  * -----------------------------------------------
- * The stack is a FIFO container.
+ * The stack is a LIFO container. Its elements are
+ * stored contiguously, so pushing does not allocate
+ * until the capacity is exhausted.
  *
  * @since OOP 1.0.0.0
  * @author Anatoly Frolov - contact@anafro.ru
@@ -11,50 +13,92 @@
 #pragma once
 
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace PROJECT_NAME {
     template<typename T>
     class Stack {
-        class Node {
-            Node* next;
-            T value;
-        public:
-            explicit Node(T initial_value, Node* initial_next) : value(initial_value), next(initial_next) {
-                //
-            }
-
-            Node* get_next() {
-                return next;
-            }
-
-            T& get_value() {
-                return value;
-            }
-        };
-        Node* head = nullptr;
+        std::vector<T> elements;
+
+        void ensure_has_elements(const char* action) const {
+            if(!has_elements())
+                throw std::runtime_error(std::string("Cannot ") + action + " an element from an empty stack.");
+        }
     public:
         Stack() = default;
 
-        void push(T value) {
-            head = new Node(value, head);
+        void push(const T& value) {
+            elements.push_back(value);
+        }
+
+        void push(T&& value) {
+            elements.push_back(std::move(value));
+        }
+
+        /**
+         * Constructs a new element on the top of the stack.
+         *
+         * @param arguments The arguments of the element constructor
+         * @return The new top element
+         */
+        template<typename... Arguments>
+        T& emplace(Arguments&&... arguments) {
+            return elements.emplace_back(std::forward<Arguments>(arguments)...);
         }
 
+        /**
+         * Removes the top element and moves it out of the stack.
+         *
+         * @throws std::runtime_error When the stack is empty
+         * @return The removed element
+         */
         T pop() {
-            if(!has_elements())
-                throw std::runtime_error("Cannot pop an element from an empty stack.");
+            ensure_has_elements("pop");
 
-            T stack_top = top();
-            head = head->get_next();
+            T stack_top = std::move(elements.back());
+            elements.pop_back();
 
             return stack_top;
         }
 
-        T top() {
-            return head->get_value();
+        /**
+         * Returns the top element without removing it.
+         *
+         * @throws std::runtime_error When the stack is empty
+         * @return The top element
+         */
+        T& top() {
+            ensure_has_elements("get");
+            return elements.back();
+        }
+
+        const T& top() const {
+            ensure_has_elements("get");
+            return elements.back();
+        }
+
+        [[nodiscard]]
+        bool has_elements() const {
+            return !elements.empty();
+        }
+
+        [[nodiscard]]
+        size_t size() const {
+            return elements.size();
+        }
+
+        /**
+         * Allocates the memory for the elements at once, so pushing them does not allocate.
+         * @param capacity A count of elements the stack can hold without allocating
+         */
+        void reserve(size_t capacity) {
+            elements.reserve(capacity);
         }
 
-        bool has_elements() {
-            return head != nullptr;
+        void clear() {
+            elements.clear();
         }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,119 @@
+#include <thread_safe_logger.h++>
+#include <algorithm>
+#include <iostream>
+
+namespace PROJECT_NAME {
+    static unsigned long long generate_instance_id() {
+        static std::atomic<unsigned long long> next_instance_id = 1;
+        return next_instance_id++;
+    }
+
+    struct ThreadSafeLogger::ThreadBufferOwner {
+        struct Registration {
+            unsigned long long instance_id;
+            std::weak_ptr<ThreadBufferRegistry> registry;
+            ThreadBuffer* thread_buffer;
+        };
+
+        std::vector<Registration> registrations;
+        unsigned long long cached_instance_id = 0;
+        ThreadBuffer* cached_thread_buffer = nullptr;
+
+        ~ThreadBufferOwner() {
+            for(const auto& registration : registrations) {
+                auto registry = registration.registry.lock();
+                if(!registry)
+                    continue;
+
+                std::lock_guard lock { registry->mutex };
+                if(!registry->logger)
+                    continue;
+
+                try {
+                    std::lock_guard buffer_lock { registration.thread_buffer->buffer_mutex };
+                    registry->logger->write_thread_buffer(*registration.thread_buffer);
+                } catch(const std::exception& exception) {
+                    std::cerr << exception.what() << std::endl;
+                }
+
+                std::erase_if(registry->thread_buffers, [&](const auto& thread_buffer) {
+                    return thread_buffer.get() == registration.thread_buffer;
+                });
+            }
+        }
+    };
+
+    ThreadSafeLogger::ThreadSafeLogger(std::unique_ptr<AbstractLogger> sink, size_t batch_size, std::chrono::milliseconds max_delay, MessageFormatter formatter)
+        : AbstractLogger(std::move(formatter)), instance_id(generate_instance_id()), sink(std::move(sink)), batch_size(batch_size), max_delay(max_delay), registry(std::make_shared<ThreadBufferRegistry>()) {
+        if(!this->sink)
+            throw std::invalid_argument("Thread-safe logger cannot be created without a sink");
+
+        registry->logger = this;
+    }
+
+    ThreadSafeLogger::~ThreadSafeLogger() {
+        flush();
+
+        std::lock_guard lock { registry->mutex };
+        registry->logger = nullptr;
+    }
+
+    ThreadSafeLogger::ThreadBuffer& ThreadSafeLogger::get_thread_buffer() {
+        thread_local ThreadBufferOwner owner;
+
+        if(owner.cached_instance_id == instance_id)
+            return *owner.cached_thread_buffer;
+
+        auto registration = std::find_if(owner.registrations.begin(), owner.registrations.end(), [&](const auto& registration) {
+            return registration.instance_id == instance_id;
+        });
+
+        if(registration == owner.registrations.end()) {
+            std::erase_if(owner.registrations, [](const auto& registration) {
+                return registration.registry.expired();
+            });
+
+            std::lock_guard lock { registry->mutex };
+            auto& thread_buffer = registry->thread_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+            registration = owner.registrations.insert(owner.registrations.end(), { instance_id, registry, thread_buffer.get() });
+        }
+
+        owner.cached_instance_id = instance_id;
+        owner.cached_thread_buffer = registration->thread_buffer;
+        return *registration->thread_buffer;
+    }
+
+    void ThreadSafeLogger::write_thread_buffer(ThreadBuffer& thread_buffer) {
+        if(!thread_buffer.records.empty()) {
+            std::lock_guard lock { sink_mutex };
+            sink->write(thread_buffer.records);
+        }
+
+        thread_buffer.records.clear();
+        thread_buffer.flushed_at = std::chrono::steady_clock::now();
+    }
+
+    void ThreadSafeLogger::write(const std::string& formatted_message) {
+        auto& thread_buffer = get_thread_buffer();
+
+        std::lock_guard lock { thread_buffer.buffer_mutex };
+        thread_buffer.records.append(formatted_message);
+
+        if(thread_buffer.records.size() >= batch_size || std::chrono::steady_clock::now() - thread_buffer.flushed_at >= max_delay)
+            write_thread_buffer(thread_buffer);
+    }
+
+    void ThreadSafeLogger::flush() {
+        {
+            std::lock_guard lock { registry->mutex };
+
+            for(auto& thread_buffer : registry->thread_buffers) {
+                std::lock_guard buffer_lock { thread_buffer->buffer_mutex };
+                write_thread_buffer(*thread_buffer);
+            }
+        }
+
+        std::lock_guard lock { sink_mutex };
+        sink->flush();
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * -----------------------------------------------
+ * Thread-Safe Logger
+ * -----------------------------------------------
+ * Lets many threads share a single sink. Every
+ * thread collects its formatted records in its
+ * own buffer, and the buffer is written to the
+ * sink in batches of whole records, so records
+ * never interleave and the sink lock is taken
+ * once per batch instead of once per record.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include "logger.h++"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace PROJECT_NAME {
+    class ThreadSafeLogger : public AbstractLogger {
+        struct ThreadBuffer {
+            std::mutex buffer_mutex;
+            std::string records;
+            std::chrono::steady_clock::time_point flushed_at = std::chrono::steady_clock::now();
+        };
+
+        /**
+         * The thread buffers of a logger. It is shared with the logging threads,
+         * so a thread that exits can write and remove its buffer even while
+         * the logger is being destroyed.
+         */
+        struct ThreadBufferRegistry {
+            std::mutex mutex;
+            ThreadSafeLogger* logger;
+            std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers;
+        };
+
+        /**
+         * The thread-local list of buffers the calling thread has in all the loggers.
+         * When the thread exits, it writes them to their sinks and removes them.
+         */
+        struct ThreadBufferOwner;
+
+        const unsigned long long instance_id;
+        std::unique_ptr<AbstractLogger> sink;
+        size_t batch_size;
+        std::chrono::steady_clock::duration max_delay;
+        std::shared_ptr<ThreadBufferRegistry> registry;
+        std::mutex sink_mutex;
+
+        /**
+         * Returns the buffer of the calling thread, registering it on the first call.
+         * Later calls from the same thread do not lock anything. The buffer is
+         * written and removed when the thread exits.
+         *
+         * @return The thread buffer
+         */
+        ThreadBuffer& get_thread_buffer();
+
+        /**
+         * Writes the records of a thread buffer to the sink and clears it.
+         * The thread buffer mutex should be locked.
+         *
+         * @param thread_buffer The thread buffer
+         */
+        void write_thread_buffer(ThreadBuffer& thread_buffer);
+    public:
+        /**
+         * Creates a new thread-safe logger.
+         *
+         * @throws std::invalid_argument When the sink is missing
+         * @param sink The logger the batches will be written to
+         * @param batch_size A size of the thread buffer which makes it written to the sink
+         * @param max_delay A maximal time records of an actively logging thread stay in its buffer
+         * @param formatter The logger message formatter
+         */
+        explicit ThreadSafeLogger(std::unique_ptr<AbstractLogger> sink, size_t batch_size = 4096, std::chrono::milliseconds max_delay = std::chrono::milliseconds(100), MessageFormatter formatter = DEFAULT_FORMATTER);
+
+        ThreadSafeLogger(const ThreadSafeLogger&) = delete;
+        ThreadSafeLogger& operator=(const ThreadSafeLogger&) = delete;
+
+        /**
+         * Writes the buffers of all the threads to the sink and detaches them,
+         * so the threads that exit later do not touch this logger.
+         */
+        ~ThreadSafeLogger() override;
+
+        /**
+         * Appends a formatted message to the buffer of the calling thread.
+         *
+         * @param formatted_message The formatted message
+         */
+        void write(const std::string& formatted_message) override;
+
+        /**
+         * Writes the buffers of all the threads to the sink and flushes it.
+         * Records of threads that stopped logging but are still running reach the sink only here.
+         */
+        void flush() override;
+    };
+}
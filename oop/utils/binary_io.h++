@@ -0,0 +1,61 @@
+/*
+ * -----------------------------------------------
+ * Binary I/O
+ * -----------------------------------------------
+ * It contains helpers for reading and writing
+ * fixed-width integers to binary streams in the
+ * little-endian byte order, regardless of the
+ * platform the program is running on.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+using namespace std::string_literals;
+
+namespace PROJECT_NAME {
+    template<typename T>
+    requires std::is_unsigned_v<T>
+    static void write_binary_integer(std::ostream& stream, T value) {
+        char bytes[sizeof(T)];
+
+        for(size_t index = 0; index < sizeof(T); index++) {
+            bytes[index] = static_cast<char>((value >> (index * 8)) & 0xFF);
+        }
+
+        stream.write(bytes, sizeof(T));
+    }
+
+    template<typename T>
+    requires std::is_unsigned_v<T>
+    static void append_binary_integer(std::string& buffer, T value) {
+        for(size_t index = 0; index < sizeof(T); index++) {
+            buffer.push_back(static_cast<char>((value >> (index * 8)) & 0xFF));
+        }
+    }
+
+    template<typename T>
+    requires std::is_unsigned_v<T>
+    static T read_binary_integer(std::istream& stream) {
+        unsigned char bytes[sizeof(T)];
+
+        if(!stream.read(reinterpret_cast<char*>(bytes), sizeof(T))) {
+            throw std::runtime_error("Unexpected end of binary stream while reading "s + std::to_string(sizeof(T)) + "-byte integer");
+        }
+
+        T value = 0;
+        for(size_t index = 0; index < sizeof(T); index++) {
+            value |= static_cast<T>(bytes[index]) << (index * 8);
+        }
+
+        return value;
+    }
+}
@@ -0,0 +1,39 @@
+/*
+ * -----------------------------------------------
+ * JSON
+ * -----------------------------------------------
+ * It contains helpers shared by the reports that
+ * are exported as JSON, such as the execution
+ * profile and the logger metrics.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <utils/latency_histogram.h++>
+#include <ostream>
+#include <string>
+
+namespace PROJECT_NAME {
+    static std::string escape_json_string(const std::string& raw_string) {
+        std::string escaped_string;
+
+        for(const auto& character : raw_string) {
+            if(character == '"' || character == '\\')
+                escaped_string += '\\';
+            escaped_string += character;
+        }
+
+        return escaped_string;
+    }
+
+    static void write_latencies_json(std::ostream& json, const LatencyHistogram& latencies) {
+        json << "\"count\": " << latencies.count()
+             << ", \"total_ns\": " << latencies.sum()
+             << ", \"p50_ns\": " << latencies.percentile(50)
+             << ", \"p99_ns\": " << latencies.percentile(99)
+             << ", \"max_ns\": " << latencies.max();
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * -----------------------------------------------
+ * Latency Histogram
+ * -----------------------------------------------
+ * A log-linear histogram in the HDR style: values
+ * below 64 are counted exactly, bigger ones are
+ * grouped by a power of two and then split into
+ * 32 linear sub-buckets, so every percentile is
+ * precise within ~3% with a fixed memory usage.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+namespace PROJECT_NAME {
+    class LatencyHistogram {
+        static constexpr int SUB_BUCKET_BITS = 5;
+        static constexpr uint64_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+        static constexpr uint64_t LINEAR_LIMIT = SUB_BUCKET_COUNT * 2;
+        static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+        std::array<uint64_t, BUCKET_COUNT> buckets {};
+        uint64_t total_count = 0, total_sum = 0;
+        uint64_t minimal_value = std::numeric_limits<uint64_t>::max(), maximal_value = 0;
+
+        static size_t index_of(uint64_t value) {
+            if(value < LINEAR_LIMIT)
+                return value;
+
+            int exponent = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+            return exponent * SUB_BUCKET_COUNT + (value >> exponent);
+        }
+
+        static uint64_t highest_equivalent_value(size_t index) {
+            if(index < LINEAR_LIMIT)
+                return index;
+
+            int exponent = static_cast<int>(index / SUB_BUCKET_COUNT) - 1;
+            uint64_t mantissa = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+            return ((mantissa + 1) << exponent) - 1;
+        }
+    public:
+        /**
+         * Records a single value, e.g. a latency in nanoseconds.
+         * @param value The value
+         */
+        void record(uint64_t value) {
+            buckets[index_of(value)]++;
+            total_count++;
+            total_sum += value;
+            minimal_value = std::min(minimal_value, value);
+            maximal_value = std::max(maximal_value, value);
+        }
+
+        /**
+         * Adds all the values recorded by another histogram to this one.
+         * @param other The histogram to merge
+         */
+        void merge(const LatencyHistogram& other) {
+            for(size_t index = 0; index < BUCKET_COUNT; index++) {
+                buckets[index] += other.buckets[index];
+            }
+
+            total_count += other.total_count;
+            total_sum += other.total_sum;
+            minimal_value = std::min(minimal_value, other.minimal_value);
+            maximal_value = std::max(maximal_value, other.maximal_value);
+        }
+
+        /**
+         * Returns the value below which the passed share of recorded values falls.
+         * @param percentile A percentile from 0 to 100
+         * @return The value at the percentile, or 0 if nothing is recorded
+         */
+        [[nodiscard]]
+        uint64_t percentile(double percentile) const {
+            if(total_count == 0)
+                return 0;
+
+            auto rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total_count) + 0.5);
+            rank = std::clamp<uint64_t>(rank, 1, total_count);
+
+            uint64_t cumulative_count = 0;
+            for(size_t index = 0; index < BUCKET_COUNT; index++) {
+                cumulative_count += buckets[index];
+                if(cumulative_count >= rank) {
+                    return std::clamp(highest_equivalent_value(index), minimal_value, maximal_value);
+                }
+            }
+
+            return maximal_value;
+        }
+
+        [[nodiscard]]
+        uint64_t count() const {
+            return total_count;
+        }
+
+        [[nodiscard]]
+        uint64_t sum() const {
+            return total_sum;
+        }
+
+        [[nodiscard]]
+        uint64_t min() const {
+            return total_count == 0 ? 0 : minimal_value;
+        }
+
+        [[nodiscard]]
+        uint64_t max() const {
+            return maximal_value;
+        }
+    };
+}
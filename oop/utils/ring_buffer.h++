@@ -0,0 +1,131 @@
+/*
+ * -----------------------------------------------
+ * Ring Buffer
+ * -----------------------------------------------
+ * A bounded lock-free queue for many producers and
+ * many consumers. Every slot has a sequence number
+ * telling whether it is ready to be written or read,
+ * so pushing and popping cost a single CAS each.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace PROJECT_NAME {
+    template<typename T>
+    class RingBuffer {
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        struct alignas(CACHE_LINE_SIZE) Slot {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        size_t mask;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_position = 0;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_position = 0;
+    public:
+        /**
+         * Creates a new ring buffer.
+         *
+         * @throws std::invalid_argument When the capacity is not a power of two
+         * @param capacity A maximal count of elements, should be a power of two
+         */
+        explicit RingBuffer(size_t capacity) : slots(new Slot[capacity]), mask(capacity - 1) {
+            if(capacity < 2 || !std::has_single_bit(capacity)) {
+                throw std::invalid_argument("Ring buffer capacity should be a power of two, but it is set to " + std::to_string(capacity));
+            }
+
+            for(size_t index = 0; index < capacity; index++) {
+                slots[index].sequence.store(index, std::memory_order_relaxed);
+            }
+        }
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        /**
+         * Pushes an element if there is a free slot.
+         *
+         * @param value The element, it is moved from only if it was pushed
+         * @return True if the element was pushed, false if the buffer is full
+         */
+        bool try_push(T& value) {
+            size_t position = enqueue_position.load(std::memory_order_relaxed);
+
+            while(true) {
+                Slot& slot = slots[position & mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if(difference == 0) {
+                    if(enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        slot.value = std::move(value);
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if(difference < 0) {
+                    return false;
+                } else {
+                    position = enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Pops the oldest element if there is any.
+         *
+         * @param value The variable the element will be moved to
+         * @return True if an element was popped, false if the buffer is empty
+         */
+        bool try_pop(T& value) {
+            size_t position = dequeue_position.load(std::memory_order_relaxed);
+
+            while(true) {
+                Slot& slot = slots[position & mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+                if(difference == 0) {
+                    if(dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        value = std::move(slot.value);
+                        slot.sequence.store(position + mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if(difference < 0) {
+                    return false;
+                } else {
+                    position = dequeue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Returns an approximate count of elements, exact when nothing is pushed or popped concurrently.
+         * @return The count of elements
+         */
+        [[nodiscard]]
+        size_t size() const {
+            size_t enqueued = enqueue_position.load(std::memory_order_relaxed);
+            size_t dequeued = dequeue_position.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+        [[nodiscard]]
+        size_t capacity() const {
+            return mask + 1;
+        }
+    };
+}
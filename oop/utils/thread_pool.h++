@@ -0,0 +1,133 @@
+/*
+ * -----------------------------------------------
+ * Thread Pool
+ * -----------------------------------------------
+ * A fixed set of worker threads that run loops
+ * in parallel. The calling thread takes part in
+ * every loop as well, and the first exception
+ * thrown by an iteration is rethrown to it.
+ *
+ * @since 1.0.0.0
+ * @author Anatoly Frolov - contact@anafro.ru
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PROJECT_NAME {
+    class ThreadPool {
+        std::vector<std::thread> workers;
+        std::mutex job_mutex;
+        std::condition_variable job_started, job_finished;
+        const std::function<void(size_t)>* job = nullptr;
+        size_t job_size = 0;
+        std::atomic<size_t> next_iteration = 0;
+        size_t finished_workers_count = 0;
+        unsigned long long job_generation = 0;
+        std::exception_ptr job_exception;
+        bool stopping = false;
+
+        void run_iterations() {
+            for(size_t iteration = next_iteration++; iteration < job_size; iteration = next_iteration++) {
+                try {
+                    (*job)(iteration);
+                } catch(...) {
+                    std::lock_guard lock { job_mutex };
+                    if(!job_exception)
+                        job_exception = std::current_exception();
+                }
+            }
+        }
+
+        void work() {
+            unsigned long long seen_generation = 0;
+
+            while(true) {
+                {
+                    std::unique_lock lock { job_mutex };
+                    job_started.wait(lock, [&] { return stopping || job_generation != seen_generation; });
+
+                    if(stopping)
+                        return;
+
+                    seen_generation = job_generation;
+                }
+
+                run_iterations();
+
+                std::lock_guard lock { job_mutex };
+                if(++finished_workers_count == workers.size())
+                    job_finished.notify_all();
+            }
+        }
+    public:
+        /**
+         * Creates a new thread pool.
+         *
+         * @param thread_count A count of threads running loops, including the calling one
+         */
+        explicit ThreadPool(unsigned int thread_count = std::thread::hardware_concurrency()) {
+            for(unsigned int worker = 1; worker < thread_count; worker++) {
+                workers.emplace_back(&ThreadPool::work, this);
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock { job_mutex };
+                stopping = true;
+            }
+
+            job_started.notify_all();
+            for(auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * Calls the function for every iteration from 0 to 'iteration_count'
+         * in parallel and waits until all of them are completed.
+         *
+         * @throws Any exception thrown by the function
+         * @param iteration_count A count of iterations
+         * @param function The function accepting an iteration number
+         */
+        void parallel_for(size_t iteration_count, const std::function<void(size_t)>& function) {
+            {
+                std::lock_guard lock { job_mutex };
+                job = &function;
+                job_size = iteration_count;
+                next_iteration = 0;
+                finished_workers_count = 0;
+                job_exception = nullptr;
+                job_generation++;
+            }
+
+            job_started.notify_all();
+            run_iterations();
+
+            std::unique_lock lock { job_mutex };
+            job_finished.wait(lock, [&] { return finished_workers_count == workers.size(); });
+            job = nullptr;
+
+            if(job_exception)
+                std::rethrow_exception(job_exception);
+        }
+
+        [[nodiscard]]
+        unsigned int get_thread_count() const {
+            return workers.size() + 1;
+        }
+    };
+}
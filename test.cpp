@@ -1,9 +1,25 @@
 #include <gtest/gtest.h>
 #include <bigint.h++>
 #include <csv.h++>
+#include <csv_scanner.h++>
 #include <dictionary.h++>
+#include <concurrent_dictionary.h++>
 #include <stack.h++>
 #include <bigint_command_executor.h++>
+#include <operation_registry.h++>
+#include <command_history.h++>
+#include <async_logger.h++>
+#include <binary_logger.h++>
+#include <multi_logger.h++>
+#include <logger_metrics_dumper.h++>
+#include <log_limiter.h++>
+#include <thread_safe_logger.h++>
+#include <mapped_file_logger.h++>
+#include <rotating_file_logger.h++>
+#include <utils/ring_buffer.h++>
+#include <utils/thread_pool.h++>
+#include <utils/latency_histogram.h++>
+#include <random>
 
 using namespace PROJECT_NAME;
 
@@ -370,6 +386,139 @@ TEST(Dictionary, HasValue) {
     EXPECT_FALSE(dictionary.has("3"));
 }
 
+TEST(Dictionary, LookupWithoutThrowing) {
+    Dictionary<std::string, int> dictionary;
+    for(int index = 0; index < 10000; index++)
+        dictionary.put("key " + std::to_string(index), index);
+
+    dictionary.put("key 42", -42);
+
+    ASSERT_EQ(dictionary.size(), 10000);
+    EXPECT_EQ(dictionary[std::string_view("key 9999")], 9999);
+    EXPECT_EQ(dictionary.get("key 42"), -42);
+    EXPECT_EQ(*dictionary.find(std::string_view("key 7")), 7);
+    EXPECT_EQ(dictionary.find("missing"), nullptr);
+    EXPECT_EQ(dictionary.try_get("key 8"), 8);
+    EXPECT_EQ(dictionary.try_get(std::string_view("missing")), std::nullopt);
+    EXPECT_THROW(static_cast<void>(dictionary.get("missing")), std::runtime_error);
+
+    EXPECT_EQ(dictionary.get_keys()[3], "key 3");
+    EXPECT_EQ(dictionary.get_values()[42], -42);
+    for(auto& value : dictionary.get_values())
+        value++;
+
+    EXPECT_EQ(dictionary["key 0"], 1);
+    EXPECT_EQ(&dictionary.get_pairs(), &std::as_const(dictionary).get_pairs());
+
+    Dictionary<int, int> strided_dictionary;
+    strided_dictionary.reserve(1000);
+    for(int index = 0; index < 1000; index++)
+        strided_dictionary.put(index * 1024, index);
+
+    for(int index = 0; index < 1000; index++)
+        ASSERT_EQ(strided_dictionary[index * 1024], index);
+
+    EXPECT_FALSE(strided_dictionary.has(1));
+}
+
+TEST(ConcurrentDictionary, ReadWhileWriting) {
+    static constexpr int WRITER_COUNT = 4, READER_COUNT = 4, KEY_COUNT = 256, ROUND_COUNT = 50;
+    ConcurrentDictionary<std::string, int> dictionary(8);
+    for(int key = 0; key < KEY_COUNT; key++)
+        dictionary.put("key " + std::to_string(key), 0);
+
+    std::atomic<bool> writing = true;
+    std::atomic<int> regressions = 0;
+    std::vector<std::thread> threads;
+
+    for(int writer = 0; writer < WRITER_COUNT; writer++) {
+        threads.emplace_back([&, writer] {
+            for(int round = 1; round <= ROUND_COUNT; round++)
+                for(int key = writer; key < KEY_COUNT; key += WRITER_COUNT)
+                    dictionary.put("key " + std::to_string(key), round);
+        });
+    }
+
+    for(int reader = 0; reader < READER_COUNT; reader++) {
+        threads.emplace_back([&] {
+            std::vector<int> last_values(KEY_COUNT, 0);
+            while(writing) {
+                for(int key = 0; key < KEY_COUNT; key++) {
+                    dictionary.visit("key " + std::to_string(key), [&](const int& value) {
+                        if(value < last_values[key])
+                            regressions++;
+
+                        last_values[key] = value;
+                    });
+                }
+            }
+        });
+    }
+
+    for(int writer = 0; writer < WRITER_COUNT; writer++)
+        threads[writer].join();
+
+    writing = false;
+    for(size_t thread = WRITER_COUNT; thread < threads.size(); thread++)
+        threads[thread].join();
+
+    EXPECT_EQ(regressions, 0);
+    EXPECT_EQ(dictionary.size(), KEY_COUNT);
+    EXPECT_EQ(dictionary.get(std::string_view("key 7")), ROUND_COUNT);
+    EXPECT_EQ(dictionary.try_get("missing"), std::nullopt);
+    EXPECT_FALSE(dictionary.has("missing"));
+    EXPECT_THROW(static_cast<void>(dictionary.get("missing")), std::runtime_error);
+}
+
+struct PausingReaderHooks {
+    static inline std::atomic<bool> pausing = false, paused = false, resumed = false;
+
+    static void on_epoch_read() {
+        if(!pausing.exchange(false))
+            return;
+
+        paused = true;
+        while(!resumed)
+            std::this_thread::yield();
+    }
+};
+
+TEST(ConcurrentDictionary, ReaderPausedAcrossEpochKeepsSnapshot) {
+    ConcurrentDictionary<std::string, std::string, DictionaryHash<std::string>, PausingReaderHooks> dictionary(1);
+    dictionary.put("key", "value");
+
+    std::atomic<bool> visiting = false, writes_finished = false;
+    PausingReaderHooks::pausing = true;
+
+    std::thread reader([&] {
+        dictionary.visit("key", [&](const std::string& value) {
+            visiting = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            EXPECT_FALSE(writes_finished);
+            EXPECT_EQ(value, "value");
+        });
+    });
+
+    while(!PausingReaderHooks::paused)
+        std::this_thread::yield();
+
+    // 63 more retired snapshots start a single new epoch, so the reader resumes with a stale epoch parity.
+    for(int index = 0; index < 63; index++)
+        dictionary.put("other " + std::to_string(index), "");
+
+    PausingReaderHooks::resumed = true;
+    while(!visiting)
+        std::this_thread::yield();
+
+    // The next epoch retires the snapshot the reader is visiting.
+    for(int index = 0; index < 64; index++)
+        dictionary.put("other " + std::to_string(index), "");
+
+    writes_finished = true;
+    reader.join();
+    EXPECT_EQ(dictionary.get("key"), "value");
+}
+
 TEST(Stack, ConstructorEmpty) {
     Stack<int> stack;
 
@@ -377,6 +526,28 @@ TEST(Stack, ConstructorEmpty) {
     EXPECT_THROW(stack.pop(), std::runtime_error);
 }
 
+TEST(Stack, MoveOnlyElements) {
+    Stack<std::unique_ptr<std::string>> stack;
+    stack.reserve(1000);
+
+    for(int index = 0; index < 1000; index++)
+        stack.push(std::make_unique<std::string>(std::to_string(index)));
+
+    EXPECT_EQ(*stack.emplace(new std::string("top")), "top");
+    EXPECT_EQ(stack.size(), 1001);
+    EXPECT_EQ(*stack.pop(), "top");
+    EXPECT_EQ(*stack.top(), "999");
+
+    auto moved_stack = std::move(stack);
+    EXPECT_FALSE(stack.has_elements());
+    EXPECT_THROW(static_cast<void>(stack.top()), std::runtime_error);
+
+    for(int index = 999; index >= 0; index--)
+        ASSERT_EQ(*moved_stack.pop(), std::to_string(index));
+
+    EXPECT_FALSE(moved_stack.has_elements());
+}
+
 TEST(Stack, Manipulations) {
     Stack<int> stack;
 
@@ -413,6 +584,1028 @@ TEST(Stack, Manipulations) {
     EXPECT_FALSE(stack.has_elements());
 }
 
+TEST(BigInt, LeadingZerosAreStripped) {
+    EXPECT_STREQ(bigint("-000123").to_string().c_str(), "-123");
+    EXPECT_STREQ(bigint("-000").to_string().c_str(), "0");
+    EXPECT_STREQ((bigint("1000") - bigint("5")).to_string().c_str(), "995");
+    EXPECT_THROW(bigint {"-"}, std::invalid_argument);
+}
+
+TEST(BigInt, Carries) {
+    EXPECT_STREQ((bigint("195") + bigint("5")).to_string().c_str(), "200");
+    EXPECT_STREQ((bigint("8") * bigint("2")).to_string().c_str(), "16");
+    EXPECT_STREQ((bigint("99999") * bigint("-99")).to_string().c_str(), "-9899901");
+}
+
+TEST(BigInt, BinaryRoundTrip) {
+    std::stringstream stream;
+    bigint odd("-12345678901234567890123456789"), even("1234567890");
+    odd.write_binary(stream);
+    even.write_binary(stream);
+
+    EXPECT_EQ(stream.str().size(), (1 + 4 + 15) + (1 + 4 + 5));
+    EXPECT_EQ(bigint::read_binary(stream), odd);
+    EXPECT_EQ(bigint::read_binary(stream), even);
+    EXPECT_THROW(bigint::read_binary(stream), std::runtime_error);
+}
+
+TEST(BigIntCommandExecutor, ResumeFromCheckpoint) {
+    const std::string checkpoint_path = "executor.checkpoint";
+    const std::vector<std::string> program = { "ADD 5", "MUL 3", "SUB 7", "ADD 100", "MUL 2", "SUB 1", "ADD 12" };
+    std::remove(checkpoint_path.c_str());
+
+    bigint_command_executor uninterrupted;
+    for(const auto& command : program)
+        uninterrupted.push_command(command);
+    bigint expected = uninterrupted.run(10);
+
+    bigint_command_executor checkpointed;
+    checkpointed.set_checkpointing(checkpoint_path, 3);
+    for(const auto& command : program)
+        checkpointed.push_command(command);
+    checkpointed.run(10);
+    ASSERT_TRUE(std::filesystem::exists(checkpoint_path));
+
+    bigint_command_executor restarted;
+    for(const auto& command : program)
+        restarted.push_command(command);
+
+    EXPECT_EQ(restarted.resume(checkpoint_path), expected);
+    EXPECT_EQ(restarted.get_program_counter(), program.size());
+    std::remove(checkpoint_path.c_str());
+}
+
+TEST(LatencyHistogram, Percentiles) {
+    LatencyHistogram histogram;
+    for(uint64_t value = 1; value <= 10000; value++)
+        histogram.record(value);
+
+    EXPECT_EQ(histogram.count(), 10000);
+    EXPECT_EQ(histogram.min(), 1);
+    EXPECT_EQ(histogram.max(), 10000);
+    EXPECT_NEAR(histogram.percentile(50), 5000, 5000 * 0.04);
+    EXPECT_NEAR(histogram.percentile(99), 9900, 9900 * 0.04);
+    EXPECT_EQ(histogram.percentile(100), 10000);
+}
+
+TEST(LatencyHistogram, HighestValues) {
+    LatencyHistogram histogram;
+    histogram.record(std::numeric_limits<uint64_t>::max());
+    histogram.record(uint64_t { 1 } << 63);
+    histogram.record(static_cast<uint64_t>(int64_t { -1 }));
+
+    EXPECT_EQ(histogram.count(), 3);
+    EXPECT_EQ(histogram.min(), uint64_t { 1 } << 63);
+    EXPECT_EQ(histogram.max(), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(histogram.percentile(100), std::numeric_limits<uint64_t>::max());
+    EXPECT_GE(histogram.percentile(0), uint64_t { 1 } << 63);
+}
+
+TEST(BigIntCommandExecutor, Profiling) {
+    bigint_command_executor executor;
+    executor.enable_profiling(2);
+    executor.push_command("ADD 12345678901234567890");
+    executor.push_command("SUB 7");
+    executor.push_command("ADD 1");
+    executor.push_command("UNKNOWN 1");
+    executor.run(1);
+
+    const auto& profiler = executor.get_profiler();
+    EXPECT_EQ(profiler.get_latencies("ADD").count(), 2);
+    EXPECT_EQ(profiler.get_latencies("SUB").count(), 1);
+    EXPECT_EQ(profiler.get_latencies("UNKNOWN").count(), 0);
+    ASSERT_EQ(profiler.get_result_growth().size(), 2);
+    EXPECT_EQ(profiler.get_result_growth().back().first, 4);
+
+    auto json = profiler.to_json();
+    EXPECT_NE(json.find("\"ADD\": { \"count\": 2"), std::string::npos);
+    EXPECT_NE(json.find("\"max_digits\": 32"), std::string::npos);
+}
+
+TEST(OperationRegistry, PerfectHashLookup) {
+    OperationRegistry registry;
+    std::vector<std::string> names;
+    for(int index = 0; index < 100; index++) {
+        names.push_back("OPERATION_"s + std::to_string(index));
+        EXPECT_EQ(registry.register_operation(names.back(), [](bigint& destination, const bigint& operand) { destination += operand; }), index);
+    }
+
+    registry.finalize();
+    ASSERT_TRUE(registry.is_finalized());
+
+    for(OperationRegistry::OperationId id = 0; id < names.size(); id++)
+        EXPECT_EQ(registry.find(names[id]), id);
+
+    EXPECT_EQ(registry.find("OPERATION_100"), OperationRegistry::UNKNOWN_OPERATION);
+    EXPECT_EQ(registry.find(""), OperationRegistry::UNKNOWN_OPERATION);
+}
+
+TEST(OperationRegistry, ReplacingKeepsId) {
+    OperationRegistry registry;
+    auto id = registry.register_operation("SET", [](bigint& destination, const bigint& operand) { destination = operand; });
+    registry.finalize();
+
+    EXPECT_EQ(registry.register_operation("SET", [](bigint& destination, const bigint&) { destination = 0; }), id);
+    EXPECT_FALSE(registry.is_finalized());
+    EXPECT_EQ(registry.size(), 1);
+
+    bigint value = 42;
+    registry.invoke(registry.find("SET"), value, 7);
+    EXPECT_EQ(value, 0);
+}
+
+TEST(BigIntCommandExecutor, CustomOperation) {
+    bigint_command_executor executor;
+    executor.register_operation("SHL", [](bigint& destination, const bigint& operand) {
+        destination.set_value(destination.to_string() + std::string(std::stoi(operand.to_string()), '0'));
+    });
+
+    executor.push_command("ADD 2");
+    executor.push_command("SHL 3");
+
+    EXPECT_EQ(executor.run(5), 5002);
+}
+
+TEST(CommandHistory, UndoRedoWithInversesAndSnapshots) {
+    OperationRegistry operations;
+    auto add = operations.register_operation("ADD", [](bigint& destination, const bigint& operand) { destination += operand; });
+    auto sub = operations.register_operation("SUB", [](bigint& destination, const bigint& operand) { destination -= operand; });
+    auto mul = operations.register_operation("MUL", [](bigint& destination, const bigint& operand) { destination *= operand; });
+    operations.set_inverse(add, sub);
+
+    CommandHistory history(100, 4);
+    std::vector<std::pair<OperationRegistry::OperationId, int>> program = { {add, 5}, {mul, 3}, {sub, 7}, {add, 100}, {mul, 2}, {sub, 1}, {add, 12}, {mul, 4}, {add, 9} };
+    std::vector<bigint> values = { 10 };
+
+    bigint value = values.back();
+    for(const auto& [operation, operand] : program) {
+        history.record(operation, operand, value, operations);
+        operations.invoke(operation, value, operand);
+        values.push_back(value);
+    }
+
+    EXPECT_EQ(history.get_snapshot_count(), 3);
+
+    for(size_t step = program.size(); step > 0; step--) {
+        ASSERT_TRUE(history.undo(value, operations));
+        EXPECT_EQ(value, values[step - 1]);
+    }
+    EXPECT_FALSE(history.undo(value, operations));
+
+    for(size_t step = 1; step <= program.size(); step++) {
+        ASSERT_TRUE(history.redo(value, operations));
+        EXPECT_EQ(value, values[step]);
+    }
+    EXPECT_FALSE(history.redo(value, operations));
+}
+
+TEST(CommandHistory, DepthIsBounded) {
+    OperationRegistry operations;
+    auto mul = operations.register_operation("MUL", [](bigint& destination, const bigint& operand) { destination *= operand; });
+
+    CommandHistory history(3, 2);
+    bigint value = 1;
+    for(int step = 0; step < 10; step++) {
+        history.record(mul, 2, value, operations);
+        operations.invoke(mul, value, 2);
+    }
+
+    EXPECT_EQ(history.get_undoable_count(), 3);
+    EXPECT_LE(history.get_snapshot_count(), 2);
+
+    ASSERT_TRUE(history.undo(value, operations));
+    ASSERT_TRUE(history.undo(value, operations));
+    ASSERT_TRUE(history.undo(value, operations));
+    EXPECT_FALSE(history.undo(value, operations));
+    EXPECT_EQ(value, 128);
+}
+
+TEST(BigIntCommandExecutor, UndoAndRedo) {
+    bigint_command_executor executor;
+    executor.enable_history();
+    executor.push_command("ADD 3");
+    executor.push_command("MUL 10");
+    executor.push_command("SUB 2");
+    executor.run(5);
+
+    EXPECT_EQ(executor.get_result(), 33);
+    EXPECT_EQ(executor.undo(), 1);
+    EXPECT_EQ(executor.get_result(), 30);
+    EXPECT_EQ(executor.undo(5), 2);
+    EXPECT_EQ(executor.get_result(), 5);
+    EXPECT_EQ(executor.redo(2), 2);
+    EXPECT_EQ(executor.get_result(), 30);
+}
+
+TEST(ThreadPool, ParallelFor) {
+    ThreadPool pool(4);
+    std::vector<int> squares(1000);
+
+    for(int repetition = 0; repetition < 10; repetition++) {
+        pool.parallel_for(squares.size(), [&](size_t index) { squares[index] = index * index; });
+    }
+
+    for(size_t index = 0; index < squares.size(); index++)
+        EXPECT_EQ(squares[index], index * index);
+
+    EXPECT_THROW(pool.parallel_for(10, [](size_t index) {
+        if(index == 7)
+            throw std::runtime_error("Iteration failed");
+    }), std::runtime_error);
+}
+
+TEST(BigIntCommandExecutor, Registers) {
+    bigint_command_executor executor;
+    executor.push_command("ADD r3");
+    executor.push_command("MUL r3 r1 r2");
+    executor.push_command("SUB r2 4");
+    executor.push_command("ADD r2 10");
+    executor.push_command("ADD r1 acc");
+
+    EXPECT_EQ(executor.run(7), 49);
+    EXPECT_EQ(executor.get_register("r1"), 7);
+    EXPECT_EQ(executor.get_register("r2"), 6);
+    EXPECT_EQ(executor.get_register("r3"), 42);
+    EXPECT_THROW(static_cast<void>(executor.get_register("r4")), std::invalid_argument);
+    EXPECT_THROW(executor.push_command("ADD 5 r1"), std::invalid_argument);
+}
+
+TEST(BigIntCommandExecutor, ParallelExecutionIsDeterministic) {
+    std::vector<std::string> program;
+    for(int chain = 0; chain < 16; chain++) {
+        std::string name = "r"s + std::to_string(chain);
+        program.push_back("ADD " + name + " " + std::to_string(chain + 1));
+        for(int step = 0; step < 20; step++) {
+            program.push_back("MUL " + name + " " + name + " 3");
+            program.push_back("SUB " + name + " " + std::to_string(step));
+        }
+        program.push_back("ADD " + name);
+    }
+
+    std::vector<bigint> results;
+    for(unsigned int thread_count : { 1u, 4u }) {
+        bigint_command_executor executor;
+        executor.set_thread_count(thread_count);
+        for(auto command = program.rbegin(); command != program.rend(); command++)
+            executor.push_command(*command);
+
+        results.push_back(executor.run(0));
+    }
+
+    EXPECT_EQ(results[0], results[1]);
+}
+
+TEST(RingBuffer, PushAndPop) {
+    RingBuffer<int> buffer(4);
+    int value = 0;
+
+    EXPECT_FALSE(buffer.try_pop(value));
+    for(int element = 1; element <= 4; element++)
+        EXPECT_TRUE(buffer.try_push(element));
+
+    value = 5;
+    EXPECT_FALSE(buffer.try_push(value));
+    EXPECT_EQ(buffer.size(), 4);
+
+    for(int element = 1; element <= 4; element++) {
+        EXPECT_TRUE(buffer.try_pop(value));
+        EXPECT_EQ(value, element);
+    }
+
+    EXPECT_THROW(RingBuffer<int>(6), std::invalid_argument);
+}
+
+class CapturingLogger : public AbstractLogger {
+    std::vector<std::string>& messages;
+    std::atomic<bool>* paused;
+public:
+    explicit CapturingLogger(std::vector<std::string>& messages, std::atomic<bool>* paused = nullptr) : messages(messages), paused(paused) {
+        //
+    }
+
+    void write(const std::string& formatted_message) override {
+        while(paused && *paused)
+            std::this_thread::yield();
+
+        messages.push_back(formatted_message);
+    }
+};
+
+TEST(AsyncLogger, FlushWritesEverything) {
+    std::vector<std::string> messages;
+    AsyncLogger logger(std::make_unique<CapturingLogger>(messages), 64, OverflowPolicy::BLOCK, MESSAGE_AND_LOG_LEVEL_FORMATTER);
+
+    for(int index = 0; index < 1000; index++)
+        logger.info(std::to_string(index));
+
+    logger.error("Done");
+    logger.flush();
+
+    ASSERT_EQ(messages.size(), 1001);
+    EXPECT_EQ(messages[0], "[INFO]: 0\n");
+    EXPECT_EQ(messages[999], "[INFO]: 999\n");
+    EXPECT_EQ(messages[1000], "[ERROR]: Done\n");
+    EXPECT_EQ(logger.get_dropped_count(), 0);
+}
+
+TEST(AsyncLogger, DropWhenFull) {
+    std::vector<std::string> messages;
+    std::atomic<bool> paused = true;
+
+    {
+        AsyncLogger logger(std::make_unique<CapturingLogger>(messages, &paused), 8, OverflowPolicy::DROP, KEEP_ONLY_MESSAGE_FORMATTER);
+
+        for(int index = 0; index < 100; index++)
+            logger.info(std::to_string(index));
+
+        EXPECT_GE(logger.get_dropped_count(), 100 - 8 - 1);
+        paused = false;
+        logger.flush();
+        EXPECT_EQ(messages.size() + logger.get_dropped_count(), 100);
+    }
+
+    EXPECT_EQ(messages[0], "0\n");
+}
+
+TEST(AsyncLogger, DestructorDrainsTheBuffer) {
+    std::vector<std::string> messages;
+
+    {
+        AsyncLogger logger(std::make_unique<CapturingLogger>(messages), 1024, OverflowPolicy::DROP_OLDEST);
+        for(int index = 0; index < 500; index++)
+            logger.write(std::to_string(index));
+    }
+
+    ASSERT_EQ(messages.size(), 500);
+    EXPECT_EQ(messages[499], "499");
+}
+
+TEST(MessageFormatter, PrecompiledPatterns) {
+    MessageFormatter formatter("%level|%message|%unknown|%message");
+    EXPECT_EQ(formatter.format("Hello", WARNING), "WARNING|Hello|%unknown|Hello\n");
+
+    auto timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(1700000000042));
+    std::string buffer = "> ";
+    MessageFormatter("%time.%ms %message").format_to(buffer, "Tick", INFO, timestamp);
+    ASSERT_EQ(buffer.size(), 2 + 12 + 6);
+    EXPECT_EQ(buffer.substr(2 + 8, 4), ".042");
+    EXPECT_EQ(buffer.substr(14), " Tick\n");
+
+    MessageFormatter::register_pattern("file", [](std::string& buffer, const std::string&, const LogLevel&, std::chrono::system_clock::time_point) {
+        buffer.append("test.cpp");
+    });
+    EXPECT_EQ(MessageFormatter("[%file] %message").format("Custom", INFO), "[test.cpp] Custom\n");
+    EXPECT_THROW(MessageFormatter::register_pattern("", nullptr), std::invalid_argument);
+}
+
+TEST(Logger, LevelFiltering) {
+    std::vector<std::string> messages;
+    CapturingLogger logger(messages);
+    int built_messages_count = 0;
+    auto build_message = [&] {
+        built_messages_count++;
+        return "Built"s;
+    };
+
+    logger.set_level(WARNING);
+    EXPECT_FALSE(logger.is_enabled(INFO));
+    EXPECT_TRUE(logger.is_enabled(ERROR));
+
+    logger.debug("Debug");
+    logger.info("Info");
+    logger.log(INFO, build_message);
+    OOP_LOG_INFO(logger, build_message());
+    logger.warning("Warning");
+    logger.log(ERROR, build_message);
+    OOP_LOG_ERROR(logger, build_message());
+
+    EXPECT_EQ(built_messages_count, 2);
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_NE(messages[0].find("[WARNING] Warning"), std::string::npos);
+    EXPECT_NE(messages[2].find("[ERROR] Built"), std::string::npos);
+    EXPECT_LT(TRACE.get_severity(), DEBUG.get_severity());
+    EXPECT_LT(INFO.get_severity(), WARNING.get_severity());
+}
+
+class AuditingLogger : public AbstractLogger {
+    std::vector<std::string>& messages;
+    AbstractLogger& audit_logger;
+public:
+    AuditingLogger(std::vector<std::string>& messages, AbstractLogger& audit_logger) : messages(messages), audit_logger(audit_logger) {
+        //
+    }
+
+    void write(const std::string& formatted_message) override {
+        audit_logger.info("Writing a message");
+        messages.push_back(formatted_message);
+    }
+};
+
+TEST(Logger, SinkLoggingWhileWriting) {
+    std::vector<std::string> messages, audit_messages;
+    CapturingLogger audit_logger(audit_messages);
+    AuditingLogger logger(messages, audit_logger);
+
+    logger.error("Original message");
+
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_NE(messages[0].find("[ERROR] Original message"), std::string::npos);
+    ASSERT_EQ(audit_messages.size(), 1);
+    EXPECT_NE(audit_messages[0].find("Writing a message"), std::string::npos);
+}
+
+TEST(RotatingFileLogger, RotatesBySizeAndCompresses) {
+    auto directory = std::filesystem::temp_directory_path() / "oop-rotating-file-logger-test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    auto filename = (directory / "job.log").string();
+
+    RotatingFileLoggerOptions options;
+    options.buffer_size = 64;
+    options.max_file_size = 100;
+    options.max_rotated_files = 2;
+    options.compressed_extension = ".z";
+    options.compressor = [](const std::string& path) {
+        std::filesystem::rename(path, path + ".z");
+    };
+    options.fsync_policy = FsyncPolicy::EVERY_N_RECORDS;
+    options.fsync_records_count = 3;
+
+    {
+        RotatingFileLogger logger(filename, options, KEEP_ONLY_MESSAGE_FORMATTER);
+        for(int index = 0; index < 40; index++)
+            logger.info("Record number " + std::to_string(index));
+    }
+
+    EXPECT_TRUE(std::filesystem::exists(filename));
+    EXPECT_TRUE(std::filesystem::exists(filename + ".1.z"));
+    EXPECT_TRUE(std::filesystem::exists(filename + ".2.z"));
+    EXPECT_FALSE(std::filesystem::exists(filename + ".3.z"));
+    EXPECT_LE(std::filesystem::file_size(filename), 100);
+
+    std::ifstream current_file(filename);
+    std::string last_line, line;
+    while(std::getline(current_file, line))
+        last_line = line;
+
+    EXPECT_EQ(last_line, "Record number 39");
+    std::filesystem::remove_all(directory);
+}
+
+TEST(RotatingFileLogger, GzipCompressorDoesNotUseShell) {
+    auto directory = std::filesystem::temp_directory_path() / "oop-gzip-compressor-test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    auto filename = (directory / "job's $(touch injected).log").string();
+
+    std::ofstream(filename) << "Record number 0" << std::endl;
+    RotatingFileLogger::gzip_compressor(filename);
+
+    EXPECT_FALSE(std::filesystem::exists(filename));
+    EXPECT_TRUE(std::filesystem::exists(filename + ".gz"));
+    EXPECT_FALSE(std::filesystem::exists("injected"));
+    EXPECT_FALSE(std::filesystem::exists(directory / "injected"));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(BinaryLogger, WriteAndDecode) {
+    auto filename = (std::filesystem::temp_directory_path() / "oop-binary-logger-test.blog").string();
+
+    {
+        BinaryLogger logger(filename, 32);
+        for(int index = 0; index < 3; index++)
+            OOP_BINARY_LOG(logger, WARNING, "Step {} of {}: {} and {}", index, 3u, -1.5, bigint("-12345678901234567890"));
+
+        OOP_BINARY_LOG(logger, ERROR, "No arguments");
+        logger.set_level(ERROR);
+        OOP_BINARY_LOG(logger, INFO, "Disabled {}", "string");
+        logger.error("Text message");
+        logger.log("Custom level", LogLevel("FATAL", OOP_LOG_LEVEL_ERROR));
+        logger.write("Preformatted\n");
+    }
+
+    BinaryLogReader reader(filename);
+    BinaryLogRecord record;
+    std::vector<BinaryLogRecord> records;
+    while(reader.next(record))
+        records.push_back(record);
+
+    ASSERT_EQ(records.size(), 7);
+    EXPECT_EQ(records[2].message, "Step 2 of 3: -1.5 and -12345678901234567890");
+    EXPECT_EQ(records[2].level_tag, "WARNING");
+    EXPECT_EQ(records[3].message, "No arguments");
+    EXPECT_EQ(BinaryLogReader::render(records[4], MESSAGE_AND_LOG_LEVEL_FORMATTER), "[ERROR]: Text message\n");
+    EXPECT_EQ(BinaryLogReader::render(records[5], MESSAGE_AND_LOG_LEVEL_FORMATTER), "[FATAL]: Custom level\n");
+    EXPECT_EQ(BinaryLogReader::render(records[6], MESSAGE_AND_LOG_LEVEL_FORMATTER), "Preformatted\n");
+    EXPECT_LE(records[0].timestamp, records[6].timestamp);
+
+    std::filesystem::remove(filename);
+    EXPECT_THROW(BinaryLogReader("test.cpp"), std::runtime_error);
+}
+
+TEST(MultiLogger, SlowSinkDoesNotBlockOthers) {
+    std::vector<std::string> fast_messages, slow_messages;
+    std::atomic<bool> paused = true;
+
+    MultiLogger logger(MESSAGE_AND_LOG_LEVEL_FORMATTER);
+    logger.add_sink(std::make_unique<CapturingLogger>(fast_messages));
+    logger.add_sink(std::make_unique<CapturingLogger>(slow_messages, &paused), 16, OverflowPolicy::DROP);
+    ASSERT_EQ(logger.get_sink_count(), 2);
+
+    for(int index = 0; index < 100; index++)
+        logger.warning(std::to_string(index));
+
+    EXPECT_GT(logger.get_sink(1).get_dropped_count(), 0);
+    paused = false;
+    logger.flush();
+
+    ASSERT_EQ(fast_messages.size(), 100);
+    EXPECT_EQ(fast_messages[99], "[WARNING]: 99\n");
+    EXPECT_EQ(slow_messages.size() + logger.get_sink(1).get_dropped_count(), 100);
+    EXPECT_EQ(logger.get_sink(0).get_write_latencies().count(), 100);
+    EXPECT_EQ(logger.get_sink(0).get_queue_size(), 0);
+    EXPECT_THROW(static_cast<void>(logger.get_sink(2)), std::out_of_range);
+}
+
+TEST(LoggerMetrics, SnapshotsAndDumps) {
+    std::vector<std::string> messages;
+    CapturingLogger logger(messages);
+    logger.info("Not counted");
+
+    logger.enable_metrics();
+    for(int index = 0; index < 10; index++)
+        logger.log("Message", WARNING);
+
+    auto snapshot = logger.snapshot();
+    EXPECT_EQ(snapshot.records_count, 10);
+    EXPECT_EQ(snapshot.bytes_count, messages[1].size() * 10);
+    EXPECT_EQ(snapshot.caller_latencies.count(), 10);
+    EXPECT_EQ(snapshot.formatting_latencies.count(), 10);
+    EXPECT_EQ(snapshot.writing_latencies.count(), 10);
+    EXPECT_GT(snapshot.get_records_per_second(), 0);
+
+    logger.disable_metrics();
+    logger.info("Not counted");
+    EXPECT_EQ(logger.snapshot().records_count, 10);
+
+    std::vector<std::string> async_messages;
+    std::atomic<bool> paused = true;
+    AsyncLogger async_logger(std::make_unique<CapturingLogger>(async_messages, &paused), 4, OverflowPolicy::DROP);
+    async_logger.enable_metrics();
+    for(int index = 0; index < 10; index++)
+        async_logger.info("Message");
+
+    EXPECT_GT(async_logger.snapshot().dropped_count, 0);
+    EXPECT_EQ(async_logger.snapshot().caller_latencies.count(), 10);
+    paused = false;
+    async_logger.flush();
+    EXPECT_EQ(async_logger.snapshot().records_count + async_logger.snapshot().dropped_count, 10);
+    EXPECT_EQ(async_logger.snapshot().queue_size, 0);
+
+    std::vector<std::string> blocking_messages;
+    std::atomic<bool> blocking_paused = true;
+    AsyncLogger blocking_logger(std::make_unique<CapturingLogger>(blocking_messages, &blocking_paused), 2, OverflowPolicy::BLOCK);
+    blocking_logger.enable_metrics();
+    std::thread unpausing_thread([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        blocking_paused = false;
+    });
+    for(int index = 0; index < 5; index++)
+        blocking_logger.info("Message");
+
+    unpausing_thread.join();
+    EXPECT_EQ(blocking_logger.snapshot().caller_latencies.count(), 5);
+    EXPECT_GE(blocking_logger.snapshot().caller_latencies.max(), 10'000'000);
+
+    auto dump_filename = (std::filesystem::temp_directory_path() / "oop-logger-metrics-test.jsonl").string();
+    std::filesystem::remove(dump_filename);
+    {
+        LoggerMetricsDumper dumper(logger, dump_filename, std::chrono::milliseconds(5));
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+
+    std::ifstream dump_file(dump_filename);
+    std::string line;
+    int line_count = 0;
+    while(std::getline(dump_file, line)) {
+        EXPECT_NE(line.find("\"records\": 10,"), std::string::npos);
+        line_count++;
+    }
+
+    EXPECT_GE(line_count, 2);
+    std::filesystem::remove(dump_filename);
+}
+
+TEST(LogLimiter, SamplingAndTokenBucket) {
+    std::vector<std::string> messages;
+    CapturingLogger logger(messages, nullptr);
+
+    for(int index = 0; index < 25; index++)
+        OOP_LOG_SAMPLED(logger, ERROR, 3, 10, "Sampled "s + std::to_string(index));
+
+    ASSERT_EQ(messages.size(), 5);
+    EXPECT_NE(messages[2].find("Sampled 2"), std::string::npos);
+    EXPECT_NE(messages[3].find("Sampled 12 (9 similar messages suppressed)"), std::string::npos);
+    EXPECT_NE(messages[4].find("Sampled 22 (9 similar messages suppressed)"), std::string::npos);
+
+    messages.clear();
+    for(int index = 0; index < 100; index++)
+        OOP_LOG_RATE_LIMITED(logger, WARNING, 0.001, 5, "Limited");
+
+    EXPECT_EQ(messages.size(), 5);
+
+    uint64_t suppressed_count = 0;
+    TokenBucketLimiter bucket(1000000, 1);
+    EXPECT_TRUE(bucket.try_acquire(suppressed_count));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_TRUE(bucket.try_acquire(suppressed_count));
+    EXPECT_THROW(SamplingLimiter(1, 0), std::invalid_argument);
+}
+
+TEST(LogLimiter, Deduplication) {
+    std::vector<std::string> messages;
+    CapturingLogger logger(messages, nullptr);
+
+    for(const auto& message : { "A", "A", "A", "B", "B", "A" })
+        OOP_LOG_DEDUPLICATED(logger, ERROR, std::chrono::hours(1), message);
+
+    ASSERT_EQ(messages.size(), 5);
+    EXPECT_NE(messages[0].find("] A"), std::string::npos);
+    EXPECT_NE(messages[1].find("Previous message repeated 2 times"), std::string::npos);
+    EXPECT_NE(messages[2].find("] B"), std::string::npos);
+    EXPECT_NE(messages[3].find("Previous message repeated 1 times"), std::string::npos);
+    EXPECT_NE(messages[4].find("] A"), std::string::npos);
+}
+
+TEST(ThreadSafeLogger, RecordsDoNotInterleave) {
+    std::vector<std::string> batches;
+    constexpr int THREAD_COUNT = 4, RECORD_COUNT = 2000;
+
+    {
+        ThreadSafeLogger logger(std::make_unique<CapturingLogger>(batches), 256, std::chrono::milliseconds(1000), MessageFormatter("%thread %message"));
+        std::vector<std::thread> threads;
+
+        for(int thread = 0; thread < THREAD_COUNT; thread++) {
+            threads.emplace_back([&] {
+                for(int index = 0; index < RECORD_COUNT; index++)
+                    logger.info("record-" + std::to_string(index));
+            });
+        }
+
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    std::map<std::string, int> next_record_index;
+    int record_count = 0;
+    for(const auto& batch : batches) {
+        ASSERT_EQ(batch.back(), '\n');
+        std::stringstream lines(batch);
+        std::string thread_number, record;
+
+        while(lines >> thread_number >> record) {
+            EXPECT_EQ(record, "record-" + std::to_string(next_record_index[thread_number]++));
+            record_count++;
+        }
+    }
+
+    EXPECT_EQ(record_count, THREAD_COUNT * RECORD_COUNT);
+    EXPECT_EQ(next_record_index.size(), THREAD_COUNT);
+    EXPECT_LT(batches.size(), record_count / 10);
+    EXPECT_NE(get_thread_number(), 0);
+}
+
+TEST(ThreadSafeLogger, ExitingThreadWritesItsBuffer) {
+    std::vector<std::string> batches;
+    ThreadSafeLogger logger(std::make_unique<CapturingLogger>(batches), 4096, std::chrono::milliseconds(60000), KEEP_ONLY_MESSAGE_FORMATTER);
+
+    for(int index = 0; index < 3; index++) {
+        std::thread([&] {
+            logger.info("record-" + std::to_string(index));
+        }).join();
+    }
+
+    ASSERT_EQ(batches.size(), 3);
+    EXPECT_EQ(batches[0], "record-0\n");
+    EXPECT_EQ(batches[2], "record-2\n");
+}
+
+TEST(MappedFileLogger, ConcurrentWritesAndRollover) {
+    auto directory = std::filesystem::temp_directory_path() / "oop-mapped-file-logger-test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    auto filename = (directory / "trace.log").string();
+    constexpr int THREAD_COUNT = 4, RECORD_COUNT = 500;
+
+    {
+        MappedFileLogger logger(filename, 4096, MessageFormatter("%thread %message"));
+        std::vector<std::thread> threads;
+
+        for(int thread = 0; thread < THREAD_COUNT; thread++) {
+            threads.emplace_back([&] {
+                for(int index = 0; index < RECORD_COUNT; index++)
+                    logger.info("record-" + std::to_string(index));
+            });
+        }
+
+        for(auto& thread : threads)
+            thread.join();
+
+        EXPECT_THROW(logger.write(std::string(8192, 'x')), std::invalid_argument);
+    }
+
+    std::map<std::string, int> next_record_index;
+    int record_count = 0, segment_count = 0;
+    for(auto segment = filename; std::filesystem::exists(segment); segment = filename + "." + std::to_string(++segment_count)) {
+        EXPECT_LE(std::filesystem::file_size(segment), 4096);
+
+        std::istringstream segment_file(MappedFileLogger::read_segment(segment));
+        std::string thread_number, record;
+        while(segment_file >> thread_number >> record) {
+            EXPECT_EQ(record, "record-" + std::to_string(next_record_index[thread_number]++));
+            record_count++;
+        }
+    }
+
+    EXPECT_GT(segment_count, 3);
+    EXPECT_EQ(record_count, THREAD_COUNT * RECORD_COUNT);
+
+    auto crashed_filename = (directory / "crashed.log").string();
+    {
+        MappedFileLogger logger(filename, 4096, MessageFormatter("%message"));
+        logger.info("first");
+        logger.info("second");
+        logger.sync();
+        std::filesystem::copy_file(filename, crashed_filename);
+    }
+
+    EXPECT_EQ(std::filesystem::file_size(crashed_filename), 4096);
+    EXPECT_EQ(MappedFileLogger::read_segment(crashed_filename), "first\nsecond\n");
+    EXPECT_EQ(MappedFileLogger::read_segment(filename), "first\nsecond\n");
+    EXPECT_THROW(static_cast<void>(MappedFileLogger::read_segment((directory / "missing.log").string())), std::runtime_error);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(CSV, StreamRowsAcrossChunks) {
+    std::string raw_csv;
+    for(int index = 0; index < 20000; index++)
+        raw_csv += std::to_string(index) + ",\"multi\nline, \"\"quoted\"\" " + std::to_string(index) + "\",plain\n\n";
+
+    std::stringstream csv_stream(raw_csv);
+    int row_count = 0;
+    for(const auto& row : CSV().rows(csv_stream)) {
+        ASSERT_EQ(row.size(), 3);
+        EXPECT_EQ(row[0], std::to_string(row_count));
+        EXPECT_EQ(row[1], "multi\nline, \"quoted\" " + std::to_string(row_count));
+        EXPECT_EQ(row[2], "plain");
+        row_count++;
+    }
+
+    EXPECT_EQ(row_count, 20000);
+
+    std::stringstream simple_csv_stream("lorem,ipsum\ndolor,\"sit, amet\",\nconsectetur");
+    std::vector<std::vector<std::string>> table;
+    for(const auto& row : CSV().rows(simple_csv_stream))
+        table.push_back(row);
+
+    EXPECT_EQ(table, CSV().parse("lorem,ipsum\ndolor,\"sit, amet\",\nconsectetur"));
+
+    std::string long_cell(200000, 'x');
+    std::stringstream long_csv_stream("a,\"" + long_cell + "\",b\nc");
+    table.clear();
+    for(const auto& row : CSV().rows(long_csv_stream))
+        table.push_back(row);
+
+    EXPECT_EQ(table, (std::vector<std::vector<std::string>> { { "a", long_cell, "b" }, { "c" } }));
+
+    std::stringstream unclosed_csv_stream("lorem,\"ipsum\n");
+    auto rows = CSV().rows(unclosed_csv_stream);
+    std::vector<std::string> row;
+    EXPECT_THROW(rows.next(row), std::runtime_error);
+}
+
+TEST(CSV, MapFileWithoutCopyingCells) {
+    auto filename = (std::filesystem::temp_directory_path() / "oop-csv-document-test.csv").string();
+    std::string raw_csv = "lorem,ipsum\n\ndolor,\"sit, amet\",\nconsectetur,\"multi\nline \"\"quoted\"\"\",a\"b,c\"d";
+    std::ofstream { filename, std::ios::binary } << raw_csv;
+
+    {
+        auto document = CSV().map_file(filename);
+        ASSERT_EQ(document.size(), 3);
+        EXPECT_EQ(document.at(0).size(), 2);
+        EXPECT_EQ(document[1][1], "sit, amet");
+        EXPECT_EQ(document[2][1], "multi\nline \"quoted\"");
+        EXPECT_EQ(document[2][2], "ab,cd");
+        EXPECT_EQ(document.get_unescaped_cell_count(), 2);
+        EXPECT_EQ(document.to_table(), CSV().parse_file(filename));
+        EXPECT_THROW(static_cast<void>(document.at(3)), std::out_of_range);
+
+        auto moved_document = std::move(document);
+        EXPECT_EQ(moved_document[0][0], "lorem");
+        EXPECT_EQ(document.size(), 0);
+    }
+
+    std::ofstream { filename, std::ios::binary | std::ios::trunc } << "lorem,\"ipsum\n";
+    EXPECT_THROW(static_cast<void>(CSV().map_file(filename)), std::runtime_error);
+
+    std::ofstream { filename, std::ios::binary | std::ios::trunc };
+    EXPECT_EQ(CSV().map_file(filename).size(), 0);
+
+    std::filesystem::remove(filename);
+    EXPECT_THROW(static_cast<void>(CSV().map_file(filename)), std::runtime_error);
+}
+
+TEST(CSVScanner, AllImplementationsFindSameSeparators) {
+    std::mt19937 random_generator(43);
+    std::string alphabet = "ab,\"\n";
+    std::string raw_csv;
+    for(int index = 0; index < 10000; index++)
+        raw_csv += alphabet[random_generator() % alphabet.size()];
+
+    auto expected_separators = [&] {
+        std::vector<size_t> separators;
+        bool in_group = false;
+        for(size_t position = 0; position < raw_csv.size(); position++) {
+            if(raw_csv[position] == '"')
+                in_group = !in_group;
+            else if(!in_group && (raw_csv[position] == ',' || raw_csv[position] == '\n'))
+                separators.push_back(position);
+        }
+
+        return std::make_pair(separators, in_group);
+    }();
+
+    for(auto implementation : { CSVScannerImplementation::SCALAR, CSVScannerImplementation::SSE42, CSVScannerImplementation::AVX2 }) {
+        if(!CSVScanner::is_supported(implementation))
+            continue;
+
+        for(size_t chunk_size : { 1, 63, 64, 1000, 10000 }) {
+            CSVScanner scanner { ',', '"', implementation };
+            std::vector<size_t> separators;
+            for(size_t chunk_start = 0; chunk_start < raw_csv.size(); chunk_start += chunk_size)
+                scanner.scan(std::string_view(raw_csv).substr(chunk_start, chunk_size), chunk_start, separators);
+
+            EXPECT_EQ(separators, expected_separators.first);
+            EXPECT_EQ(scanner.is_in_group(), expected_separators.second);
+        }
+    }
+
+    EXPECT_TRUE(CSVScanner::is_supported(CSVScanner::get_best_implementation()));
+    EXPECT_THROW(CSVScanner(',', ','), std::invalid_argument);
+}
+
+TEST(CSV, ParseFileInParallel) {
+    auto filename = (std::filesystem::temp_directory_path() / "oop-csv-parallel-test.csv").string();
+    {
+        std::ofstream csv_file { filename, std::ios::binary };
+        for(int index = 0; index < 100000; index++)
+            csv_file << index << ",\"multi\nline, \"\"quoted\"\" " << index << "\",plain\n\n";
+
+        csv_file << "huge,\"";
+        for(int index = 0; index < 300000; index++)
+            csv_file << "a,\n\"\"b";
+        csv_file << "\",end\n";
+
+        for(int index = 0; index < 100000; index++)
+            csv_file << "lorem,ipsum," << index << '\n';
+    }
+
+    ThreadPool thread_pool(4);
+    auto expected_table = CSV().parse_file(filename);
+    ASSERT_EQ(expected_table.size(), 200001);
+
+    auto csv_document = CSV().map_file(filename, thread_pool);
+    EXPECT_GT(csv_document.get_chunk_count(), 1);
+    EXPECT_EQ(csv_document.to_table(), expected_table);
+    EXPECT_EQ(CSV().parse_file(filename, thread_pool), expected_table);
+
+    std::mutex chunks_mutex;
+    std::map<size_t, std::vector<std::vector<std::string>>> chunks;
+    CSV().parse_file(filename, thread_pool, [&](size_t chunk_index, std::vector<std::vector<std::string>>& rows) {
+        std::lock_guard lock { chunks_mutex };
+        chunks[chunk_index] = std::move(rows);
+    });
+
+    std::vector<std::vector<std::string>> concatenated_table;
+    for(auto& [chunk_index, rows] : chunks)
+        concatenated_table.insert(concatenated_table.end(), rows.begin(), rows.end());
+
+    EXPECT_EQ(chunks.size(), csv_document.get_chunk_count());
+    EXPECT_EQ(concatenated_table, expected_table);
+
+    std::ofstream { filename, std::ios::app } << "\"unclosed";
+    EXPECT_THROW(static_cast<void>(CSV().map_file(filename, thread_pool)), std::runtime_error);
+    std::filesystem::remove(filename);
+}
+
+TEST(CSV, LoadTypedColumns) {
+    auto filename = (std::filesystem::temp_directory_path() / "oop-csv-columns-test.csv").string();
+    std::ofstream { filename, std::ios::binary } << "1,-2.5,123456789012345678901234567890,red,ignored\n"
+                                                    "-9000000000,1e3,-7,green,\"ignored, too\"\n"
+                                                    "42,0.125,0,red,\n";
+
+    ThreadPool thread_pool(2);
+    auto columns = CSV().load_columns(filename, {
+        { 3, CSVColumnType::STRING },
+        { 0, CSVColumnType::INT64 },
+        { 1, CSVColumnType::DOUBLE },
+        { 2, CSVColumnType::BIGINT }
+    }, thread_pool);
+
+    ASSERT_EQ(columns.get_row_count(), 3);
+    ASSERT_EQ(columns.get_column_count(), 4);
+
+    EXPECT_EQ(columns[0].get_strings().dictionary, std::vector<std::string>({ "red", "green" }));
+    EXPECT_EQ(columns[0].get_strings().codes, std::vector<uint32_t>({ 0, 1, 0 }));
+    EXPECT_EQ(columns[0].get_strings()[1], "green");
+    EXPECT_EQ(columns[1].get_integers(), std::vector<int64_t>({ 1, -9000000000, 42 }));
+    EXPECT_EQ(columns[2].get_doubles(), std::vector<double>({ -2.5, 1000.0, 0.125 }));
+    EXPECT_EQ(columns[3].get_bigints()[0].to_string(), "123456789012345678901234567890");
+    EXPECT_EQ(columns[3].get_bigints()[1].to_string(), "-7");
+    EXPECT_EQ(columns[3].get_index(), 2);
+    EXPECT_EQ(columns[3].size(), 3);
+    EXPECT_THROW(static_cast<void>(columns[1].get_doubles()), std::logic_error);
+
+    EXPECT_THROW(static_cast<void>(CSV().load_columns(filename, { { 3, CSVColumnType::INT64 } })), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(CSV().load_columns(filename, { { 4, CSVColumnType::STRING } })), std::runtime_error);
+    EXPECT_EQ(CSV().load_columns(filename, { { 0, CSVColumnType::INT64 } })[0].get_integers().back(), 42);
+    std::filesystem::remove(filename);
+}
+
+TEST(CSVWriter, QuoteOnlyWhenNeededAndRoundTrip) {
+    auto filename = (std::filesystem::temp_directory_path() / "oop-csv-writer-test.csv").string();
+    std::filesystem::remove(filename);
+
+    std::vector<std::vector<std::string>> csv_table = {
+        { "lorem", "ipsum" },
+        { "dolor, sit", "say \"amet\"", "multi\nline" },
+        { "consectetur" },
+        { "x", "" },
+        { "" },
+        { "", "y" }
+    };
+
+    CSV().export_file(filename, csv_table);
+    std::stringstream raw_csv;
+    raw_csv << std::ifstream(filename).rdbuf();
+    EXPECT_EQ(raw_csv.str(), "lorem,ipsum\n\"dolor, sit\",\"say \"\"amet\"\"\",\"multi\nline\"\nconsectetur\nx,\"\"\n\"\"\n,y\n");
+    EXPECT_EQ(CSV().parse(raw_csv.str()), csv_table);
+    EXPECT_EQ(CSV().parse_file(filename), csv_table);
+    EXPECT_EQ(CSV().map_file(filename).to_table(), csv_table);
+
+    {
+        auto csv_writer = CSV().writer(filename, CSVWriteMode::APPEND);
+        csv_writer.write_row({ "adipiscing", "elit" });
+    }
+
+    csv_table.push_back({ "adipiscing", "elit" });
+    EXPECT_EQ(CSV().parse_file(filename), csv_table);
+
+    {
+        CSVWriter csv_writer { filename, CSVWriteMode::ATOMIC_REPLACE, ';', '\'' };
+        csv_writer.write_row(std::vector<std::string> { "not", "committed" });
+    }
+
+    EXPECT_EQ(CSV().parse_file(filename), csv_table);
+
+    {
+        CSVWriter csv_writer { filename, CSVWriteMode::ATOMIC_REPLACE, ';', '\'', 16 };
+        for(int index = 0; index < 1000; index++)
+            csv_writer.write_row(std::vector<std::string> { std::to_string(index), "it's;quoted" });
+
+        EXPECT_EQ(CSV().parse_file(filename), csv_table);
+        csv_writer.close();
+        EXPECT_THROW(csv_writer.flush(), std::logic_error);
+    }
+
+    auto replaced_table = CSV(';', '\'').parse_file(filename);
+    ASSERT_EQ(replaced_table.size(), 1000);
+    EXPECT_EQ(replaced_table[999], std::vector<std::string>({ "999", "it's;quoted" }));
+    std::filesystem::remove(filename);
+}
+
+TEST(CSV, AppendRowsAndCompact) {
+    auto filename = (std::filesystem::temp_directory_path() / "oop-csv-append-test.csv").string();
+    std::filesystem::remove(filename);
+
+    CSV().append_row(filename, { "alice", "1" });
+    CSV().append_row(filename, { "bob", "1" });
+    CSV().append_row(filename, { "alice", "2, updated" });
+    CSV().append_row(filename, { "carol" });
+    CSV().append_row(filename, { "bob", "2" });
+
+    EXPECT_EQ(CSV().parse_file(filename).size(), 5);
+    EXPECT_EQ(CSV().compact_file(filename), 2);
+    EXPECT_EQ(CSV().parse_file(filename), std::vector<std::vector<std::string>>({
+        { "alice", "2, updated" },
+        { "carol" },
+        { "bob", "2" }
+    }));
+
+    EXPECT_EQ(CSV().compact_file(filename, 1), 0);
+    std::filesystem::remove(filename);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();